@@ -0,0 +1,27 @@
+// Replacing the global operator new is the only portable way to see every
+// allocation made inside a kernel, including those from std containers.
+// Kept in its own TU so callers never see malloc and operator delete inlined
+// together, and every delete overload funnels into one deallocation path.
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<long long> g_allocCount{0};
+
+void* CountedAlloc(std::size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+}
+
+long long AllocCount() { return g_allocCount.load(std::memory_order_relaxed); }
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
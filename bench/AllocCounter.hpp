@@ -0,0 +1,7 @@
+#pragma once
+// Counts every call to the global operator new in the linking executable.
+// Link AllocCounter.cpp into a target to replace the global allocation
+// functions; code under test is unchanged.
+
+// Heap allocations made so far by this process
+long long AllocCount();
@@ -0,0 +1,442 @@
+// Kernel microbenchmarks for the simulation hot paths.
+// Usage: microcosm_bench [--filter SUBSTR] [--min-time SECONDS] [--json PATH]
+//
+// Every benchmark is seeded, so two runs of the same build exercise identical
+// inputs. Results are reported as ns/op and heap allocations/op; --json writes
+// the same numbers in a form that can be diffed between commits.
+#include "AllocCounter.hpp"
+#include "World.hpp"
+#include "Activation.hpp"
+#include "BrainBatch.hpp"
+#include "Config.hpp"
+#include "NeuralNetwork.hpp"
+#include "RNNBrain.hpp"
+#include "NEATBrain.hpp"
+#include "Speciation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// --- Private World access ---
+struct WorldBenchAccess {
+    static void RebuildGrid(World& w) { w.RebuildGrid(); }
+    static void SyncGrid(World& w) { w.SyncGrid(); }
+    static void RefreshObstacles(World& w) { w.RefreshObstacles(); }
+    static SensorData Scan(World& w, int i) { return w.ScanSurroundings(i); }
+    static void Interact(World& w, int i, std::vector<Agent>& babies) { w.HandleInteractions(i, babies); }
+    static bool Collide(World& w, Vec2 pos, float radius) { return w.CheckObstacleCollision(pos, radius); }
+};
+
+namespace {
+
+struct BenchOptions {
+    std::string filter;
+    double minTime = 0.2;
+    std::string jsonPath;
+};
+
+struct BenchResult {
+    std::string name;
+    double nsPerOp;
+    double allocsPerOp;
+    long long ops;
+};
+
+BenchOptions g_options;
+std::vector<BenchResult> g_results;
+
+// Runs `body` (which performs `opsPerBatch` operations) until at least
+// minTime seconds have been measured. `reset` runs before every batch and is
+// excluded from both the timing and the allocation count.
+void RunBench(const std::string& name, int opsPerBatch,
+              const std::function<void()>& reset, const std::function<void()>& body) {
+    if (!g_options.filter.empty() && name.find(g_options.filter) == std::string::npos) return;
+
+    using Clock = std::chrono::steady_clock;
+    // Warm-up batch: faults in caches and lets containers reach steady-state capacity
+    if (reset) reset();
+    body();
+
+    double elapsed = 0.0;
+    long long allocs = 0;
+    long long ops = 0;
+    while (elapsed < g_options.minTime) {
+        if (reset) reset();
+        long long allocStart = AllocCount();
+        auto start = Clock::now();
+        body();
+        auto end = Clock::now();
+        allocs += AllocCount() - allocStart;
+        elapsed += std::chrono::duration<double>(end - start).count();
+        ops += opsPerBatch;
+    }
+
+    BenchResult r{name, elapsed * 1e9 / ops, (double)allocs / ops, ops};
+    std::printf("%-48s %12.1f ns/op %10.2f allocs/op %10lld ops\n", r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.ops);
+    g_results.push_back(r);
+}
+
+void RunBench(const std::string& name, int opsPerBatch, const std::function<void()>& body) {
+    RunBench(name, opsPerBatch, nullptr, body);
+}
+
+// Prevents the optimizer from discarding results
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    static const void* volatile sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+const char* SizeName(Config::SimSize size) {
+    switch (size) {
+        case Config::SimSize::Small: return "small";
+        case Config::SimSize::Medium: return "medium";
+        case Config::SimSize::Large: return "large";
+        case Config::SimSize::Huge: return "huge";
+        case Config::SimSize::Custom: return "custom";
+    }
+    return "?";
+}
+
+// --- World kernels ---
+
+void BenchWorldKernels(Config::SimSize size, bool maze) {
+    Config::SetSimSize(size);
+    World world(42);
+    if (maze) world.GenerateMaze();
+    WorldBenchAccess::RefreshObstacles(world);
+    WorldBenchAccess::RebuildGrid(world);
+
+    std::string suffix = std::string("/") + SizeName(size) + (maze ? "/maze" : "/open");
+    int agentCount = (int)world.agents.size();
+
+    RunBench("grid_rebuild" + suffix, 1, [&] {
+        WorldBenchAccess::RebuildGrid(world);
+    });
+
+    // Incremental upkeep after a typical tick of movement: every agent moves a
+    // couple of pixels, so only the few that cross a cell edge get relinked
+    Config::INCREMENTAL_GRID = true;
+    float step = 2.0f;
+    RunBench("grid_sync" + suffix, 1, [&] {
+        for (Vec2& p : world.agents.pos) {
+            p.x += step;
+            if (p.x >= Config::WORLD_W) p.x -= Config::WORLD_W;
+        }
+    }, [&] {
+        WorldBenchAccess::SyncGrid(world);
+    });
+    WorldBenchAccess::RebuildGrid(world);
+
+    RunBench("scan_surroundings" + suffix, agentCount, [&] {
+        for (int i = 0; i < agentCount; ++i) {
+            SensorData d = WorldBenchAccess::Scan(world, i);
+            DoNotOptimize(d);
+        }
+    });
+
+    // Interactions consume fruit and spawn babies; restore that state before each batch
+    EntityPool<Fruit> fruitSnapshot = world.fruits;
+    EntityPool<Poison> poisonSnapshot = world.poisons;
+    std::vector<float> energySnapshot = world.agents.energy;
+    std::vector<Agent> babies;
+    RunBench("handle_interactions" + suffix, agentCount, [&] {
+        world.fruits = fruitSnapshot;
+        world.poisons = poisonSnapshot;
+        world.agents.energy = energySnapshot;
+        babies.clear();
+    }, [&] {
+        for (int i = 0; i < agentCount; ++i) WorldBenchAccess::Interact(world, i, babies);
+    });
+    world.fruits = fruitSnapshot;
+    world.poisons = poisonSnapshot;
+
+    Rng queryRng(7);
+    std::vector<Vec2> queries(1024);
+    for (auto& q : queries) q = {RandomFloat(queryRng, 0, (float)Config::WORLD_W), RandomFloat(queryRng, 0, (float)Config::WORLD_H)};
+    RunBench("check_obstacle_collision" + suffix, (int)queries.size(), [&] {
+        int hits = 0;
+        for (const auto& q : queries) hits += WorldBenchAccess::Collide(world, q, 6.0f);
+        DoNotOptimize(hits);
+    });
+
+    // Exact-shape path for comparison with the distance field
+    Config::OBSTACLE_SDF = false;
+    RunBench("check_obstacle_collision_exact" + suffix, (int)queries.size(), [&] {
+        int hits = 0;
+        for (const auto& q : queries) hits += WorldBenchAccess::Collide(world, q, 6.0f);
+        DoNotOptimize(hits);
+    });
+    Config::OBSTACLE_SDF = true;
+
+    RunBench("obstacle_field_bake" + suffix, 1, [&] {
+        world.obstacleField.Bake(world.obstacles, Config::WORLD_W, Config::WORLD_H, Config::SDF_CELL_SIZE, Config::SdfBand());
+    });
+}
+
+// --- Brain kernels ---
+
+void BenchBrain(const std::string& label, const IBrain& prototype, const IBrain& partner) {
+    Rng rng(1234);
+    std::vector<float> inputs(prototype.GetInputSize());
+    for (auto& v : inputs) v = RandomFloat(rng, -1.0f, 1.0f);
+
+    std::vector<float> outputs(prototype.GetOutputSize());
+
+    std::unique_ptr<IBrain> brain = prototype.Clone();
+    const int batch = 256;
+
+    RunBench(label + "/feed_forward", batch, [&] {
+        for (int i = 0; i < batch; ++i) {
+            brain->FeedForward(inputs, outputs);
+            DoNotOptimize(outputs.data());
+        }
+    });
+
+    RunBench(label + "/learn_from_reward", batch, [&] {
+        for (int i = 0; i < batch; ++i) brain->LearnFromReward(i & 1 ? 1.0f : -1.0f, 0.01f);
+    });
+
+    // Mutation can grow NEAT topologies, so every batch starts from the prototype
+    std::vector<std::unique_ptr<IBrain>> mutants(64);
+    RunBench(label + "/mutate", (int)mutants.size(), [&] {
+        for (auto& m : mutants) m = prototype.Clone();
+    }, [&] {
+        for (auto& m : mutants) m->Mutate(0.1f, 0.15f, rng);
+    });
+
+    RunBench(label + "/crossover", batch, [&] {
+        for (int i = 0; i < batch; ++i) {
+            auto child = prototype.Crossover(partner, rng);
+            DoNotOptimize(child.get());
+        }
+    });
+
+    RunBench(label + "/clone", batch, [&] {
+        for (int i = 0; i < batch; ++i) {
+            auto copy = prototype.Clone();
+            DoNotOptimize(copy.get());
+        }
+    });
+}
+
+// A population of same-shape networks, per agent versus through BrainBatch
+// (which packs the feed-forward ones and steps recurrent ones in place)
+template <typename BrainT>
+void BenchPopulation(const std::string& kind, int hidden, int count) {
+    Rng rng(hidden * 31 + count);
+    std::vector<std::unique_ptr<IBrain>> brains;
+    for (int i = 0; i < count; ++i) brains.push_back(std::make_unique<BrainT>(BRAIN_INPUTS, hidden, BRAIN_OUTPUTS, rng));
+    std::vector<uint8_t> active(count, 1);
+    std::vector<float> inputs((size_t)count * BRAIN_INPUTS);
+    std::vector<float> outputs((size_t)count * BRAIN_OUTPUTS);
+    for (auto& v : inputs) v = RandomFloat(rng, -1.0f, 1.0f);
+
+    std::string label = "population/" + kind + "_h" + std::to_string(hidden) + "/" + std::to_string(count);
+    RunBench(label + "/per_agent", count, [&] {
+        for (int i = 0; i < count; ++i) {
+            brains[i]->FeedForward(std::span<const float>(inputs).subspan((size_t)i * BRAIN_INPUTS, BRAIN_INPUTS),
+                                   std::span<float>(outputs).subspan((size_t)i * BRAIN_OUTPUTS, BRAIN_OUTPUTS));
+        }
+        DoNotOptimize(outputs.data());
+    });
+
+    BrainBatch batch;
+    RunBench(label + "/batched", count, [&] {
+        batch.Run(brains, active, {}, inputs, outputs);
+        DoNotOptimize(outputs.data());
+    });
+
+    // Worst case: every brain reported changed, so every lane is repacked
+    std::vector<int> allRows(count);
+    for (int i = 0; i < count; ++i) allRows[i] = i;
+    RunBench(label + "/batched_repack", count, [&] {
+        batch.Run(brains, active, allRows, inputs, outputs);
+        DoNotOptimize(outputs.data());
+    });
+}
+
+// --- Activation kernels ---
+
+// One op is one element. Inputs span the range pre-activation sums actually
+// take, and are restored before every batch since the kernels work in place.
+void BenchActivations() {
+    const int n = 4096;
+    Rng rng(99);
+    std::vector<float> source(n);
+    for (auto& v : source) v = RandomFloat(rng, -6.0f, 6.0f);
+    std::vector<float> values(n);
+    auto restore = [&] { std::copy(source.begin(), source.end(), values.begin()); };
+
+    for (auto mode : {Config::ActivationMode::Exact, Config::ActivationMode::Rational, Config::ActivationMode::Polynomial}) {
+        std::string label = std::string("activation/") + Activation::ModeName(mode);
+        RunBench(label + "/tanh", n, restore, [&] {
+            Activation::Tanh(values, mode);
+            DoNotOptimize(values.data());
+        });
+        RunBench(label + "/tanh_scalar", n, restore, [&] {
+            for (float& v : values) v = Activation::Tanh(v, mode);
+            DoNotOptimize(values.data());
+        });
+        RunBench(label + "/sigmoid", n, restore, [&] {
+            Activation::Sigmoid(values, mode);
+            DoNotOptimize(values.data());
+        });
+    }
+    RunBench("activation/relu", n, restore, [&] {
+        Activation::Relu(values);
+        DoNotOptimize(values.data());
+    });
+}
+
+// Grows a NEAT genome by forcing structural mutations
+Genome GrowGenome(int inputs, int outputs, int structuralSteps, InnovationRegistry& innovations, Rng& rng) {
+    Genome g;
+    g.Initialize(inputs, outputs, rng, innovations);
+    for (int i = 0; i < structuralSteps; ++i) {
+        g.MutateAddNode(1.0f, rng, innovations);
+        g.MutateAddConnection(1.0f, rng, innovations);
+    }
+    return g;
+}
+
+void BenchBrains() {
+    const int inputs = 7;
+    const int outputs = 3;
+
+    for (int hidden : {8, 32, 128}) {
+        Rng rng(hidden);
+        NeuralNetwork a(inputs, hidden, outputs, rng);
+        NeuralNetwork b(inputs, hidden, outputs, rng);
+        BenchBrain("nn/h" + std::to_string(hidden), a, b);
+    }
+
+    for (int hidden : {8, 32, 128}) {
+        Rng rng(hidden + 1);
+        RNNBrain a(inputs, hidden, outputs, rng);
+        RNNBrain b(inputs, hidden, outputs, rng);
+        BenchBrain("rnn/h" + std::to_string(hidden), a, b);
+    }
+
+    for (int steps : {0, 16, 64}) {
+        Rng rng(steps + 2);
+        auto innovations = std::make_shared<InnovationRegistry>();
+        Genome ga = GrowGenome(inputs, outputs, steps, *innovations, rng);
+        Genome gb = GrowGenome(inputs, outputs, steps, *innovations, rng);
+        NEATBrain a(ga, inputs, outputs, innovations);
+        NEATBrain b(gb, inputs, outputs, innovations);
+        BenchBrain("neat/grown" + std::to_string(steps), a, b);
+    }
+
+    // A generation's worth of NEAT genomes: a few lineages, each with
+    // mutated descendants, sorted into species against cached representatives
+    {
+        InnovationRegistry innovations;
+        Rng rng(6);
+        std::vector<Genome> lineages;
+        for (int l = 0; l < 16; ++l) lineages.push_back(GrowGenome(inputs, outputs, 8 + l, innovations, rng));
+        std::vector<Genome> population;
+        for (int i = 0; i < 4096; ++i) {
+            Genome g = lineages[i % lineages.size()];
+            g.MutateWeight(0.3f, 0.5f, rng);
+            g.MutateAddConnection(0.1f, rng, innovations);
+            g.MutateAddNode(0.05f, rng, innovations);
+            population.push_back(std::move(g));
+        }
+        std::vector<const Genome*> genomes;
+        for (const Genome& g : population) genomes.push_back(&g);
+        std::vector<float> fitness(population.size(), 1.0f);
+
+        RunBench("neat/compatibility_distance", (int)population.size(), [&] {
+            float sum = 0.0f;
+            for (size_t i = 0; i < population.size(); ++i) sum += CompatibilityDistance(population[i], population[(i * 7 + 3) % population.size()]);
+            DoNotOptimize(sum);
+        });
+
+        Speciation speciation;
+        std::vector<int> speciesOf;
+        speciation.Assign(genomes, fitness, speciesOf);
+        RunBench("neat/speciate/4096", (int)population.size(), [&] {
+            speciation.Assign(genomes, fitness, speciesOf);
+            DoNotOptimize(speciesOf.data());
+        });
+    }
+
+    // Structural mutations in a busy generation: mostly repeats of links
+    // already numbered this generation, some new ones
+    {
+        InnovationRegistry innovations;
+        Rng rng(5);
+        const int batch = 1024;
+        RunBench("neat/innovations/connection", batch, [&] {
+            for (int i = 0; i < batch; ++i) {
+                int from = InnovationRegistry::FIRST_HIDDEN_ID + rng.Index(256);
+                int to = InnovationRegistry::FIRST_HIDDEN_ID + rng.Index(256);
+                DoNotOptimize(innovations.Connection(from, to));
+            }
+        });
+    }
+
+    for (int count : {256, 4096}) {
+        BenchPopulation<NeuralNetwork>("nn", 8, count);
+        BenchPopulation<RNNBrain>("rnn", 8, count);
+    }
+    BenchPopulation<NeuralNetwork>("nn", 32, 4096);
+    BenchPopulation<RNNBrain>("rnn", 32, 4096);
+}
+
+bool ParseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && hasValue) g_options.filter = argv[++i];
+        else if (std::strcmp(arg, "--min-time") == 0 && hasValue) g_options.minTime = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--json") == 0 && hasValue) g_options.jsonPath = argv[++i];
+        else return false;
+    }
+    return true;
+}
+
+bool WriteJson(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        std::fprintf(f, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, \"ops\": %lld}%s\n",
+                     r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.ops, i + 1 < g_results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (!ParseArgs(argc, argv)) {
+        std::printf("Usage: %s [--filter SUBSTR] [--min-time SECONDS] [--json PATH]\n", argv[0]);
+        return 1;
+    }
+
+    BenchWorldKernels(Config::SimSize::Medium, false);
+    BenchWorldKernels(Config::SimSize::Huge, false);
+    BenchWorldKernels(Config::SimSize::Huge, true);
+    BenchActivations();
+    BenchBrains();
+
+    if (!g_options.jsonPath.empty() && !WriteJson(g_options.jsonPath)) {
+        std::fprintf(stderr, "Could not write %s\n", g_options.jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
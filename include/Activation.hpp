@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include "Config.hpp"
+
+// Neuron activations for the brains. tanh comes in three accuracies,
+// picked by Config::ACTIVATION:
+//
+//   Exact       std::tanh
+//   Rational    13/6 rational fit on [-7.9, 7.9], +-1 outside.
+//               Max abs error ~4e-7 (a few float ulps).
+//   Polynomial  Odd cubic-in-x^2 on [0, 1), degree 6 in (|x| - 1) on [1, 5),
+//               1 beyond. Max abs error ~1e-4. Needs no division, for
+//               targets where that is slow; on x86-64 Rational is as fast.
+//
+// The span overloads are the ones to use on whole layers: their loops have
+// no branches or calls, so the compiler vectorizes them at whatever width
+// the target has (SSE2/AVX2 on x86-64, NEON on ARM; configure with
+// MICROCOSM_NATIVE_ARCH=ON to let it use everything the build host has).
+// Sigmoid is tanh rescaled, so it inherits half of tanh's error.
+namespace Activation {
+
+    inline float TanhRational(float x) {
+        x = std::max(-7.90531110763549805f, std::min(x, 7.90531110763549805f));
+        float x2 = x * x;
+        float p = -2.76076847742355e-16f;
+        p = p * x2 + 2.00018790482477e-13f;
+        p = p * x2 + -8.60467152213735e-11f;
+        p = p * x2 + 5.12229709037114e-08f;
+        p = p * x2 + 1.48572235717979e-05f;
+        p = p * x2 + 6.37261928875436e-04f;
+        p = p * x2 + 4.89352455891786e-03f;
+        p = p * x;
+        float q = 1.19825839466702e-06f;
+        q = q * x2 + 1.18534705686654e-04f;
+        q = q * x2 + 2.26843463243900e-03f;
+        q = q * x2 + 4.89352518554385e-03f;
+        return p / q;
+    }
+
+    inline float TanhPolynomial(float x) {
+        float t = std::min(std::fabs(x), 5.0f);
+        float t2 = t * t;
+        float inner = t * (0.9996937757819879f + t2 * (-0.3288920555620884f + t2 * (0.11541387933248949f + t2 * -0.0246541228898174f)));
+        float u = t - 1.0f;
+        float outer = -0.0003371773773690436f;
+        outer = outer * u + 0.005666326636915475f;
+        outer = outer * u + -0.03983282569846306f;
+        outer = outer * u + 0.15184456447592845f;
+        outer = outer * u + -0.337047339692725f;
+        outer = outer * u + 0.42223610593325994f;
+        outer = outer * u + 0.761565729017571f;
+        // Both pieces are evaluated and one selected, which keeps the
+        // span loop free of branches
+        float y = t < 1.0f ? inner : outer;
+        y = t < 5.0f ? y : 1.0f;
+        return std::copysign(y, x);
+    }
+
+    inline float Tanh(float x, Config::ActivationMode mode = Config::ACTIVATION) {
+        switch (mode) {
+            case Config::ActivationMode::Rational: return TanhRational(x);
+            case Config::ActivationMode::Polynomial: return TanhPolynomial(x);
+            default: return std::tanh(x);
+        }
+    }
+
+    inline float Sigmoid(float x, Config::ActivationMode mode = Config::ACTIVATION) {
+        return 0.5f + 0.5f * Tanh(0.5f * x, mode);
+    }
+
+    inline float Relu(float x) { return std::max(x, 0.0f); }
+
+    // In place over a whole layer
+    void Tanh(std::span<float> values, Config::ActivationMode mode = Config::ACTIVATION);
+    void Sigmoid(std::span<float> values, Config::ActivationMode mode = Config::ACTIVATION);
+    void Relu(std::span<float> values);
+
+    const char* ModeName(Config::ActivationMode mode);
+}
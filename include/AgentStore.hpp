@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Entities.hpp"
+
+// Stable handle to an agent. Dense indices shift whenever an agent dies;
+// a handle keeps naming the same agent until it is removed, after which the
+// slot's generation moves on and lookups fail instead of finding whoever
+// reused it.
+struct AgentId {
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    uint32_t slot = NONE;
+    uint32_t generation = 0;
+
+    bool Valid() const { return slot != NONE; }
+    bool operator==(const AgentId&) const = default;
+};
+
+// Reference to one agent spread across the store's columns, so tools and the
+// UI can keep writing `a.energy` or `a.active = false`. Valid until the store
+// is resized; the simulation itself works on the columns.
+struct AgentRef {
+    AgentId id;
+    Vec2& pos;
+    Vec2& prevPos;
+    float& angle;
+    float& prevAngle;
+    float& energy;
+    uint8_t& active;
+    Phenotype& phenotype;
+    Sex& sex;
+    float& pheromoneEmission;
+    std::unique_ptr<IBrain>& brain;
+    Rng& rng;
+    AgentLife& life;
+    AgentTrace& trace;
+
+    float CalculateFitness() const { return life.CalculateFitness(); }
+};
+
+// Agents stored column by column (structure of arrays). The per-tick loops
+// touch position, heading, energy and phenotype for every agent, so those
+// sit in dense arrays of their own; brains, RNG streams and bookkeeping are
+// side tables indexed the same way. Index i across all columns is agent i.
+//
+// The columns stay dense: removing an agent moves the last one into its
+// place. AgentIds go through a slot map (slot -> dense index, plus a
+// generation per slot), so handles survive that shuffle and lookup is O(1).
+class AgentStore {
+public:
+    // Hot columns
+    std::vector<Vec2> pos;
+    std::vector<Vec2> prevPos;     // State at the start of the last tick, for render interpolation
+    std::vector<float> angle;
+    std::vector<float> prevAngle;
+    std::vector<float> energy;
+    std::vector<uint8_t> active;
+    std::vector<Phenotype> phenotype;
+    std::vector<Sex> sex;
+    std::vector<float> pheromoneEmission;
+
+    // Side tables
+    std::vector<std::unique_ptr<IBrain>> brain;
+    std::vector<Rng> rng;
+    std::vector<AgentLife> life;
+    std::vector<AgentTrace> trace;
+    std::vector<AgentId> id;
+
+    int Add(Agent&& a);
+    // Swap-and-pop: the last agent takes index i. Its handle stays valid.
+    void SwapRemove(int i);
+    void Clear();
+    void Reserve(size_t n);
+
+    // Rows whose brain was replaced (Add, SwapRemove) or marked through
+    // MarkBrainChanged() since the last ClearBrainChanged(); a row can
+    // appear more than once. Lets BrainBatch repack only what changed.
+    const std::vector<int>& BrainChanged() const { return brainChanged; }
+    void MarkBrainChanged(int i) { brainChanged.push_back(i); }
+    void ClearBrainChanged() { brainChanged.clear(); }
+
+    size_t size() const { return pos.size(); }
+    bool empty() const { return pos.empty(); }
+    int CountActive() const;
+
+    // Dense index of a live agent, or -1 once it has been removed
+    int IndexOf(AgentId handle) const {
+        if (handle.slot >= slotIndex.size() || slotGeneration[handle.slot] != handle.generation) return -1;
+        return (int)slotIndex[handle.slot];
+    }
+
+    AgentRef operator[](int i) {
+        return {id[i], pos[i], prevPos[i], angle[i], prevAngle[i], energy[i], active[i], phenotype[i], sex[i],
+                pheromoneEmission[i], brain[i], rng[i], life[i], trace[i]};
+    }
+
+    // Start-of-tick snapshot used to interpolate rendering
+    void SnapshotPrevious() {
+        prevPos = pos;
+        prevAngle = angle;
+    }
+
+private:
+    template <typename F>
+    void ForEachColumn(F&& fn) {
+        fn(pos); fn(prevPos); fn(angle); fn(prevAngle); fn(energy); fn(phenotype); fn(sex);
+        fn(pheromoneEmission); fn(brain); fn(rng); fn(life); fn(trace); fn(active); fn(id);
+    }
+
+    // Slot map. A free slot's generation is already bumped past every
+    // handle that was given out for it.
+    std::vector<uint32_t> slotIndex;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+
+    std::vector<int> brainChanged;
+};
@@ -1,24 +1,32 @@
 #pragma once
 #include <vector>
 #include <memory>
-#include "imgui.h" 
+#include <span>
+#include <string>
+#include "Random.hpp"
+
+// Agent brains map the sensor readings to the motor outputs (see World::SenseAgent)
+constexpr int BRAIN_INPUTS = 7;
+constexpr int BRAIN_OUTPUTS = 3;
 
 struct IBrain {
     virtual ~IBrain() = default;
 
     // Core functionality
-    virtual std::vector<float> FeedForward(const std::vector<float>& inputs) = 0;
+    // Reads GetInputSize() values and writes GetOutputSize() values into the
+    // caller's buffer. Scratch state lives in the brain, so a call never allocates.
+    virtual void FeedForward(std::span<const float> inputs, std::span<float> outputs) = 0;
     
     // Genetic Algorithm operators
-    virtual void Mutate(float rate, float strength) = 0;
-    virtual std::unique_ptr<IBrain> Crossover(const IBrain& other) const = 0;
+    // All randomness comes from the caller's stream so runs are reproducible
+    virtual void Mutate(float rate, float strength, Rng& rng) = 0;
+    virtual std::unique_ptr<IBrain> Crossover(const IBrain& other, Rng& rng) const = 0;
     virtual std::unique_ptr<IBrain> Clone() const = 0;
     
     // Optional learning (Backprop/RL)
     virtual void LearnFromReward(float reward, float learningRate) = 0;
 
-    // Visualization
-    virtual void Draw(ImVec2 pos, ImVec2 size) = 0;
+    // Visualization lives in the UI layer (see BrainViz.hpp)
     
     // Inspection
     virtual int GetInputSize() const = 0;
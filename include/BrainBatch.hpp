@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Brain.hpp"
+
+struct NeuralNetwork;
+
+// Evaluates a whole population's brains for one tick. Feed-forward networks
+// that share a shape are packed LANES at a time with their weights
+// interleaved (weight k of lanes 0..LANES-1 side by side), so each step of
+// the matrix products runs across agents and the inner loops vectorize.
+// Every other brain goes through IBrain::FeedForward on its own.
+//
+// Weights only change at birth, mutation or through lifetime learning, so
+// packed blocks persist between calls: each brain keeps its lane until its
+// row is reported as changed, and only changed rows are repacked.
+//
+// Results match per-agent evaluation exactly, including the caches
+// NeuralNetwork::LearnFromReward reads afterwards.
+class BrainBatch {
+public:
+    static constexpr int LANES = 8;
+
+    // inputs/outputs hold one BRAIN_INPUTS / BRAIN_OUTPUTS row per brain;
+    // rows whose `active` entry is 0 are left untouched. `changed` lists the
+    // rows whose brain was replaced or had its weights modified since the
+    // last call (see AgentStore::BrainChanged()); rows past the previous
+    // call's brain count are picked up without being listed.
+    void Run(std::span<const std::unique_ptr<IBrain>> brains, std::span<const uint8_t> active,
+             std::span<const int> changed, std::span<const float> inputs, std::span<float> outputs);
+
+private:
+    struct Group {
+        int hidden = 0;
+        // Packed blocks, back to back: [block][k][lane] for every weight and bias
+        std::vector<float> inputW, inputB, outputW, outputB;
+        std::vector<NeuralNetwork*> laneNet;   // nullptr = free lane
+        std::vector<int> laneRow;
+        std::vector<int> freeLanes;
+    };
+
+    void Assign(int row, IBrain* brain);
+    void Release(int row);
+    void Pack(Group& group, int lane);
+    void RunGroup(const Group& group, std::span<const uint8_t> active,
+                  std::span<const float> inputs, std::span<float> outputs);
+
+    std::vector<Group> groups;   // One per hidden size seen so far
+    std::vector<int> rowGroup;   // Per row: its group, or -1 if evaluated on its own
+    std::vector<int> rowLane;
+
+    // Per-block scratch: [k][lane] inputs and activations
+    std::vector<float> x, hidden, out;
+};
@@ -0,0 +1,7 @@
+#pragma once
+#include "Brain.hpp"
+#include "imgui.h"
+
+// ImGui visualisation of the brain types. Kept out of the brains themselves
+// so microcosm_core has no ImGui dependency.
+void DrawBrain(const IBrain& brain, ImVec2 pos, ImVec2 size);
@@ -1,13 +1,20 @@
 #pragma once
-#include "raylib.h"
-#include "raymath.h"
-#include <random>
-#include <iostream>
+#include "MathUtils.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace Config {
-    inline int SCREEN_W = 1280;
-    inline int SCREEN_H = 720;
+    // Simulation bounds. The window is only a view onto the world, so the two
+    // are sized independently.
+    inline int WORLD_W = 1280;
+    inline int WORLD_H = 720;
+    inline int MAX_WORLD_SIZE = 50000;
+    inline int WINDOW_W = 1280;
+    inline int WINDOW_H = 720;
     inline int FPS = 60;
+    inline float SIM_DT = 1.0f / 60.0f;    // Fixed simulation tick, independent of the render rate
+    inline int MAX_TICKS_PER_FRAME = 16;    // Spiral-of-death guard for the accumulator
 
     inline float AGENT_VISION_RADIUS = 200.0f;
     inline float AGENT_MAX_ENERGY = 200.0f;
@@ -17,29 +24,53 @@ namespace Config {
     inline float FRUIT_ENERGY = 50.0f;
     inline float POISON_DAMAGE = 50.0f;
     
-    constexpr int GRID_CELL_SIZE = 50;
-    inline int GRID_W = SCREEN_W / GRID_CELL_SIZE + 1;
-    inline int GRID_H = SCREEN_H / GRID_CELL_SIZE + 1;
+    // Spatial grids: fine cells for contact queries (eating, mating, hunting,
+    // collision), coarse cells for vision queries. With AUTO_GRID_CELLS the
+    // sizes follow EAT_RADIUS and AGENT_VISION_RADIUS; otherwise the fixed sizes are used.
+    inline bool AUTO_GRID_CELLS = true;
+    inline int CONTACT_CELL_SIZE = 50;
+    inline int VISION_CELL_SIZE = 100;
+    inline float PHEROMONE_RADIUS = 75.0f;
+    inline bool INCREMENTAL_GRID = true;   // Update the spatial grid in place instead of rebuilding it every tick
+    inline bool VALIDATE_GRID = false;     // Debug: compare the grid against a full rebuild every tick
 
     inline int ACTIVE_AGENTS = 20;
 
-    enum class SimSize { Small, Medium, Large, Huge };
+    enum class SimSize { Small, Medium, Large, Huge, Custom };
     inline SimSize CURRENT_SIZE = SimSize::Medium;
+    inline int INITIAL_POPULATION = 0;     // 0 = derive from the world size
 
-    inline void SetWindowSize(SimSize size) {
+    // Only updates the simulation dimensions; the window keeps its size.
+    inline void SetSimSize(SimSize size) {
         CURRENT_SIZE = size;
         switch(size) {
-            case SimSize::Small:  SCREEN_W = 800;  SCREEN_H = 600;  break;
-            case SimSize::Medium: SCREEN_W = 1280; SCREEN_H = 720;  break;
-            case SimSize::Large:  SCREEN_W = 1920; SCREEN_H = 1080; break;
-            case SimSize::Huge:   SCREEN_W = 2560; SCREEN_H = 1440; break;
+            case SimSize::Small:  WORLD_W = 800;  WORLD_H = 600;  break;
+            case SimSize::Medium: WORLD_W = 1280; WORLD_H = 720;  break;
+            case SimSize::Large:  WORLD_W = 1920; WORLD_H = 1080; break;
+            case SimSize::Huge:   WORLD_W = 2560; WORLD_H = 1440; break;
+            case SimSize::Custom: break;
         }
-        GRID_W = SCREEN_W / GRID_CELL_SIZE + 1;
-        GRID_H = SCREEN_H / GRID_CELL_SIZE + 1;
-        
-        ::SetWindowSize(SCREEN_W, SCREEN_H); // Raylib function - Global scope
     }
 
+    inline void SetWorldSize(int width, int height) {
+        CURRENT_SIZE = SimSize::Custom;
+        WORLD_W = std::clamp(width, 400, MAX_WORLD_SIZE);
+        WORLD_H = std::clamp(height, 400, MAX_WORLD_SIZE);
+    }
+
+    // Entity counts for the presets; custom worlds scale the Medium count by area
+    inline int SizedCount(int small, int medium, int large, int huge) {
+        switch(CURRENT_SIZE) {
+            case SimSize::Small: return small;
+            case SimSize::Large: return large;
+            case SimSize::Huge:  return huge;
+            case SimSize::Custom:
+                return std::max(1, (int)std::lround(medium * ((double)WORLD_W * WORLD_H) / (1280.0 * 720.0)));
+            default: return medium;
+        }
+    }
+    inline int SizedCount(int count) { return SizedCount(count, count, count, count); }
+
     inline float SPEED_ENERGY_MULTIPLIER = 1.5f;
     inline float SIZE_SPEED_MULTIPLIER = 0.8f;
 
@@ -49,6 +80,15 @@ namespace Config {
 
     inline bool OBSTACLES_ENABLED = true;
     inline int OBSTACLE_COUNT = 5;
+    inline bool OBSTACLE_SDF = true;       // Collide and sense through the baked distance field instead of exact shapes
+    inline float SDF_CELL_SIZE = 4.0f;     // Distance field resolution in pixels
+    // The field is only stored this close to obstacles: the vision radius, plus
+    // a few cells so gradients at the edge of sight are still exact
+    inline float SdfBand() { return AGENT_VISION_RADIUS + 4.0f * SDF_CELL_SIZE; }
+
+    // Neuron activation accuracy (see Activation.hpp for the error bounds)
+    enum class ActivationMode { Exact, Rational, Polynomial };
+    inline ActivationMode ACTIVATION = ActivationMode::Rational;
     
     inline float COLLISION_ENERGY_PENALTY = 5.0f;
     inline float COLLISION_LEARNING_BOOST = 1.5f;
@@ -75,21 +115,17 @@ namespace Config {
     inline float CHILD_BRAIN_MUTATION_POWER = 0.15f;
     inline float CHILD_PHENOTYPE_MUTATION_RATE = 0.1f;
 
+    // NEAT speciation: compatibility distance = EXCESS*E/N + DISJOINT*D/N + WEIGHT*(mean weight difference)
+    inline float NEAT_EXCESS_COEFF = 1.0f;
+    inline float NEAT_DISJOINT_COEFF = 1.0f;
+    inline float NEAT_WEIGHT_COEFF = 0.4f;
+    inline float NEAT_COMPAT_THRESHOLD = 1.0f;  // Descendants of one genome sit near 0.1, unrelated grown genomes at 1.3+
 
-}
-
-inline std::mt19937& GetRNG() {
-    static std::mt19937 rng(std::random_device{}());
-    return rng;
-}
 
-inline float RandomFloat(float min, float max) {
-    std::uniform_real_distribution<float> dist(min, max);
-    return dist(GetRNG());
 }
 
 inline float NormalizeAngle(float angle) {
-    angle = std::fmod(angle + PI, 2.0f * PI);
-    if (angle < 0) angle += 2.0f * PI;
-    return angle - PI;
+    angle = std::fmod(angle + Math::Pi, 2.0f * Math::Pi);
+    if (angle < 0) angle += 2.0f * Math::Pi;
+    return angle - Math::Pi;
 }
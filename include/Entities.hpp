@@ -3,16 +3,17 @@
 #include "NeuralNetwork.hpp"
 #include <memory>
 #include <utility>
+#include <algorithm>
 
 enum class Sex { Male, Female };
 
 struct Fruit { 
-    Vector2 pos; 
+    Vec2 pos; 
     bool active = true; 
 };
 
 struct Poison { 
-    Vector2 pos; 
+    Vec2 pos; 
     bool active = true; 
 };
 
@@ -26,20 +27,24 @@ enum class ObstacleType {
     Corridor   // Narrow passage
 };
 
+// Render-agnostic RGBA tint (converted to a raylib Color when drawn)
+struct Tint {
+    unsigned char r, g, b, a;
+};
+
 // Enhanced Obstacle structure
 struct Obstacle {
-    Vector2 pos;
-    Vector2 size;
+    Vec2 pos;
+    Vec2 size;
     ObstacleType type;
     float rotation = 0.0f;
     bool active = true;
-    Color color = {80, 80, 80, 255};
+    Tint color = {80, 80, 80, 255};
     float radius = 0.0f;
     
-    Obstacle(Vector2 p, Vector2 s, ObstacleType t = ObstacleType::Wall);
-    bool Contains(Vector2 point) const;
-    bool Intersects(Vector2 point, float checkRadius) const;
-    void Draw() const;
+    Obstacle(Vec2 p, Vec2 s, ObstacleType t = ObstacleType::Wall);
+    bool Contains(Vec2 point) const;
+    bool Intersects(Vec2 point, float checkRadius) const;
 };
 
 struct Phenotype {
@@ -48,17 +53,7 @@ struct Phenotype {
     float size = 1.0f;       // Body size multiplier (0.7 - 1.5)
     float efficiency = 1.0f; // Metabolic efficiency (0.7 - 1.3)
     
-    Phenotype() {
-        // Random species probability
-        float r = RandomFloat(0,1);
-        if(r < 0.6f) species = Species::Herbivore;
-        else if(r < 0.85f) species = Species::Scavenger;
-        else species = Species::Predator;
-        
-        speed = RandomFloat(0.8f, 1.2f);
-        size = RandomFloat(0.85f, 1.15f);
-        efficiency = RandomFloat(0.9f, 1.1f);
-    }
+    Phenotype() = default;
     
     Phenotype(Species sp, float s, float sz, float e) : species(sp), speed(s), size(sz), efficiency(e) {}
     
@@ -74,85 +69,127 @@ struct Phenotype {
         return 5.0f * size;
     }
     
-    static Phenotype Crossover(const Phenotype& a, const Phenotype& b) {
-        return Phenotype(
-            RandomFloat(0, 1) > 0.5f ? a.species : b.species,
-            RandomFloat(0, 1) > 0.5f ? a.speed : b.speed,
-            RandomFloat(0, 1) > 0.5f ? a.size : b.size,
-            RandomFloat(0, 1) > 0.5f ? a.efficiency : b.efficiency
-        );
+    static Species RandomSpecies(Rng& rng) {
+        float r = RandomFloat(rng, 0, 1);
+        if(r < 0.6f) return Species::Herbivore;
+        if(r < 0.85f) return Species::Scavenger;
+        return Species::Predator;
+    }
+    
+    static Phenotype Random(Rng& rng) {
+        Phenotype p;
+        p.species = RandomSpecies(rng);
+        p.speed = RandomFloat(rng, 0.8f, 1.2f);
+        p.size = RandomFloat(rng, 0.85f, 1.15f);
+        p.efficiency = RandomFloat(rng, 0.9f, 1.1f);
+        return p;
+    }
+    
+    static Phenotype Crossover(const Phenotype& a, const Phenotype& b, Rng& rng) {
+        // Evaluated in a fixed order so results do not depend on argument evaluation order
+        Species sp = RandomFloat(rng, 0, 1) > 0.5f ? a.species : b.species;
+        float s = RandomFloat(rng, 0, 1) > 0.5f ? a.speed : b.speed;
+        float sz = RandomFloat(rng, 0, 1) > 0.5f ? a.size : b.size;
+        float e = RandomFloat(rng, 0, 1) > 0.5f ? a.efficiency : b.efficiency;
+        return Phenotype(sp, s, sz, e);
     }
     
-    void Mutate(float rate) {
-        if (RandomFloat(0, 1) < rate * 0.1f) { // Very low chance to change species
-             float r = RandomFloat(0,1);
-             if(r < 0.6f) species = Species::Herbivore;
-             else if(r < 0.85f) species = Species::Scavenger;
-             else species = Species::Predator;
+    void Mutate(float rate, Rng& rng) {
+        if (RandomFloat(rng, 0, 1) < rate * 0.1f) { // Very low chance to change species
+             species = RandomSpecies(rng);
         }
-        if (RandomFloat(0, 1) < rate) {
-            speed = std::clamp(speed + RandomFloat(-0.1f, 0.1f), 0.5f, 2.0f);
+        if (RandomFloat(rng, 0, 1) < rate) {
+            speed = std::clamp(speed + RandomFloat(rng, -0.1f, 0.1f), 0.5f, 2.0f);
         }
-        if (RandomFloat(0, 1) < rate) {
-            size = std::clamp(size + RandomFloat(-0.1f, 0.1f), 0.7f, 1.5f);
+        if (RandomFloat(rng, 0, 1) < rate) {
+            size = std::clamp(size + RandomFloat(rng, -0.1f, 0.1f), 0.7f, 1.5f);
         }
-        if (RandomFloat(0, 1) < rate) {
-            efficiency = std::clamp(efficiency + RandomFloat(-0.1f, 0.1f), 0.7f, 1.3f);
+        if (RandomFloat(rng, 0, 1) < rate) {
+            efficiency = std::clamp(efficiency + RandomFloat(rng, -0.1f, 0.1f), 0.7f, 1.3f);
+        }
+    }
+};
+
+// Running totals that only feed fitness and the UI
+struct AgentLife {
+    float lifespan = 0.0f;
+    int childrenCount = 0;
+    int fruitsEaten = 0;
+    int poisonsAvoided = 0;
+    int obstaclesHit = 0;
+    float totalReward = 0.0f;
+
+    float CalculateFitness() const {
+        float baseFitness = lifespan * 0.3f +
+                           childrenCount * 15.0f +
+                           fruitsEaten * 2.0f +
+                           poisonsAvoided * 0.5f +
+                           totalReward * 0.1f;
+        
+        float obstaclePenalty = obstaclesHit * 1.0f;
+        
+        if (lifespan > 0) {
+            float hitRate = obstaclesHit / lifespan;
+            if (hitRate > 0.5f) {
+                obstaclePenalty += (hitRate - 0.5f) * 10.0f;
+            }
         }
+        
+        return std::max(0.0f, baseFitness - obstaclePenalty);
     }
 };
 
+// What the sensors picked up last tick, kept for visualization/debugging
+struct AgentTrace {
+    Vec2 targetFruit = {-1, -1};
+    Vec2 targetPoison = {-1, -1};
+    float pheromoneDetected = 0.0f;
+};
+
+// One agent by value. The world keeps agents in an AgentStore (columns);
+// this record is how new agents are built and handed to it.
 struct Agent {
-    Vector2 pos;
+    Rng rng; // Private substream: mating, mutation and offspring draws
+    Vec2 pos;
     float angle;
+    Vec2 prevPos;    // State at the start of the last tick, for render interpolation
+    float prevAngle;
     float energy;
     Sex sex;
     std::unique_ptr<IBrain> brain;
     Phenotype phenotype;
     bool active = true;
-
-    float lifespan = 0.0f;
-    int childrenCount = 0;
-    int fruitsEaten = 0;
-    int poisonsAvoided = 0;
-    int obstaclesHit = 0; 
-    
-    float totalReward = 0.0f;
-    std::vector<float> lastInputs;
-    std::vector<float> lastOutputs;
-    
-    Vector2 targetFruit = {-1, -1};
-    Vector2 targetPoison = {-1, -1};
-    
     float pheromoneEmission = 0.0f; // Output
-    float pheromoneDetected = 0.0f; // Input
 
-    Agent() : pos({0,0}), angle(0), energy(0), sex(Sex::Male) {
-        brain = std::make_unique<NeuralNetwork>(7, 8, 3);
+    AgentLife life;
+    AgentTrace trace;
+
+    Agent() : pos({0,0}), angle(0), prevPos({0,0}), prevAngle(0), energy(0), sex(Sex::Male) {
+        brain = std::make_unique<NeuralNetwork>(BRAIN_INPUTS, 8, BRAIN_OUTPUTS, rng);
     }
     
-    Agent(Vector2 p) : pos(p), angle(RandomFloat(0, 2*PI)), energy(Config::AGENT_START_ENERGY), 
-                       sex(RandomFloat(0,1) > 0.5f ? Sex::Male : Sex::Female) {
-        brain = std::make_unique<NeuralNetwork>(7, 8, 3);
+    // `streams` is the parent stream (usually World::rng); the agent splits its own off it
+    Agent(Vec2 p, Rng& streams) : rng(streams.Split()), pos(p), angle(RandomFloat(rng, 0, 2*Math::Pi)), 
+                       prevPos(p), prevAngle(angle), energy(Config::AGENT_START_ENERGY),
+                       sex(RandomFloat(rng, 0,1) > 0.5f ? Sex::Male : Sex::Female) {
+        brain = std::make_unique<NeuralNetwork>(BRAIN_INPUTS, 8, BRAIN_OUTPUTS, rng);
+        phenotype = Phenotype::Random(rng);
     }
     
-    Agent(Vector2 p, const IBrain& net, const Phenotype& pheno) 
-        : pos(p), angle(RandomFloat(0, 2*PI)), 
-          energy(Config::AGENT_START_ENERGY),
-          sex(RandomFloat(0,1) > 0.5f ? Sex::Male : Sex::Female),
+    Agent(Vec2 p, const IBrain& net, const Phenotype& pheno, Rng& streams) 
+        : rng(streams.Split()), pos(p), angle(RandomFloat(rng, 0, 2*Math::Pi)), 
+          prevPos(p), prevAngle(angle), energy(Config::AGENT_START_ENERGY),
+          sex(RandomFloat(rng, 0,1) > 0.5f ? Sex::Male : Sex::Female),
           phenotype(pheno) {
           brain = net.Clone();
     }
 
     // Deep Copy Constructor
     Agent(const Agent& other) 
-        : pos(other.pos), angle(other.angle), energy(other.energy), 
+        : rng(other.rng), pos(other.pos), angle(other.angle), 
+          prevPos(other.prevPos), prevAngle(other.prevAngle), energy(other.energy), 
           sex(other.sex), phenotype(other.phenotype), active(other.active),
-          lifespan(other.lifespan), childrenCount(other.childrenCount),
-          fruitsEaten(other.fruitsEaten), poisonsAvoided(other.poisonsAvoided),
-          obstaclesHit(other.obstaclesHit), totalReward(other.totalReward),
-          lastInputs(other.lastInputs), lastOutputs(other.lastOutputs),
-          targetFruit(other.targetFruit), targetPoison(other.targetPoison)
+          pheromoneEmission(other.pheromoneEmission), life(other.life), trace(other.trace)
     {
         if (other.brain) brain = other.brain->Clone();
     }
@@ -160,25 +197,8 @@ struct Agent {
     // Deep Copy Assignment
     Agent& operator=(const Agent& other) {
         if (this != &other) {
-             pos = other.pos;
-             angle = other.angle;
-             energy = other.energy;
-             sex = other.sex;
-             phenotype = other.phenotype;
-             active = other.active;
-             lifespan = other.lifespan;
-             childrenCount = other.childrenCount;
-             fruitsEaten = other.fruitsEaten;
-             poisonsAvoided = other.poisonsAvoided;
-             obstaclesHit = other.obstaclesHit;
-             totalReward = other.totalReward;
-             lastInputs = other.lastInputs;
-             lastOutputs = other.lastOutputs;
-             targetFruit = other.targetFruit;
-             targetPoison = other.targetPoison;
-             
-             if (other.brain) brain = other.brain->Clone();
-             else brain.reset();
+            Agent copy(other);
+            *this = std::move(copy);
         }
         return *this;
     }
@@ -186,22 +206,5 @@ struct Agent {
     Agent(Agent&&) = default;
     Agent& operator=(Agent&&) = default;
     
-    float CalculateFitness() const {
-        float baseFitness = lifespan * 0.3f +
-                           childrenCount * 15.0f +
-                           fruitsEaten * 2.0f +
-                           poisonsAvoided * 0.5f +
-                           totalReward * 0.1f;
-        
-        float obstaclePenalty = obstaclesHit * 1.0f;
-        
-        if (lifespan > 0) {
-            float hitRate = obstaclesHit / lifespan;
-            if (hitRate > 0.5f) {
-                obstaclePenalty += (hitRate - 0.5f) * 10.0f;
-            }
-        }
-        
-        return std::max(0.0f, baseFitness - obstaclePenalty);
-    }
+    float CalculateFitness() const { return life.CalculateFitness(); }
 };
\ No newline at end of file
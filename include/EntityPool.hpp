@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+
+// Slot storage for static items that only appear and vanish (fruit, poison).
+// A released item's slot goes on a free list and the next spawn reuses it,
+// so indices never shift: nothing is compacted, and the spatial grid only
+// has to revisit the slots listed in Changed(). Items are read-only from
+// outside; Spawn() and Release() keep the bookkeeping in step.
+template <typename T>
+class EntityPool {
+public:
+    int Spawn(const T& item) {
+        int i;
+        if (!freeSlots.empty()) {
+            i = freeSlots.back();
+            freeSlots.pop_back();
+            items[i] = item;
+        } else {
+            i = (int)items.size();
+            items.push_back(item);
+        }
+        items[i].active = true;
+        live++;
+        changed.push_back(i);
+        return i;
+    }
+
+    void Release(int i) {
+        if (!items[i].active) return;
+        items[i].active = false;
+        live--;
+        freeSlots.push_back(i);
+        changed.push_back(i);
+    }
+
+    void Clear() {
+        items.clear();
+        freeSlots.clear();
+        changed.clear();
+        live = 0;
+    }
+
+    void Reserve(size_t n) {
+        items.reserve(n);
+        freeSlots.reserve(n);
+    }
+
+    // Slot count, live or free; loops over the pool test `active`
+    size_t size() const { return items.size(); }
+    int Live() const { return live; }
+
+    const T& operator[](int i) const { return items[i]; }
+    typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items.end(); }
+
+    // Slots spawned into or released since the last ClearChanged(); a slot
+    // can appear more than once
+    const std::vector<int>& Changed() const { return changed; }
+    void ClearChanged() { changed.clear(); }
+
+private:
+    std::vector<T> items;
+    std::vector<int> freeSlots;
+    std::vector<int> changed;
+    int live = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+// Hands out NEAT historical markings: innovation numbers for links and ids
+// for the hidden nodes that splitting a link creates. Each World owns one
+// and every NEAT brain born in it holds a reference, so separate worlds
+// (and benchmarks) never share numbering.
+//
+// Lookups are scoped to a generation. The same structural mutation made by
+// two genomes in one generation gets the same numbers, so crossover can
+// line the genes up; BeginGeneration() then forgets the table, which keeps
+// memory bounded by the mutations of a single generation. The counters
+// only ever grow, so numbers are never reused.
+//
+// Links between two initial nodes (ids below FIRST_HIDDEN_ID) have fixed
+// numbers outside the counter, so genomes seeded in different generations
+// still align on their starting topology.
+//
+// All calls lock, so mutations may run on worker threads.
+class InnovationRegistry {
+public:
+    static constexpr int FIRST_HIDDEN_ID = 1000;    // Sensors and outputs use the ids below
+    static constexpr size_t MAX_ENTRIES = 1 << 16;  // Per table; a generation that hits it starts over
+
+    // Innovation number of the link inNode -> outNode
+    int Connection(int inNode, int outNode);
+    // Id of the hidden node that splits the link inNode -> outNode
+    int SplitNode(int inNode, int outNode);
+
+    void BeginGeneration();
+    size_t Size() const;
+
+private:
+    static uint64_t Key(int inNode, int outNode) {
+        return ((uint64_t)(uint32_t)inNode << 32) | (uint32_t)outNode;
+    }
+
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, int> connections;
+    std::unordered_map<uint64_t, int> splits;
+    int nextInnovation = FIRST_HIDDEN_ID * FIRST_HIDDEN_ID + 1;
+    int nextNodeId = FIRST_HIDDEN_ID;
+};
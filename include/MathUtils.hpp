@@ -0,0 +1,38 @@
+#pragma once
+#include <cmath>
+
+// Minimal 2D math used by the simulation core.
+// The core must build without raylib, so it carries its own vector type.
+// The render layer converts with ToRaylib()/FromRaylib() (see Render.hpp).
+
+struct Vec2 {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+namespace Math {
+    constexpr float Pi = 3.14159265358979323846f;
+    constexpr float Deg2Rad = Pi / 180.0f;
+}
+
+inline Vec2 Vec2Add(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+inline Vec2 Vec2Subtract(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+inline Vec2 Vec2Scale(Vec2 v, float s) { return {v.x * s, v.y * s}; }
+inline float Vec2Length(Vec2 v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+
+inline float Vec2DistanceSqr(Vec2 a, Vec2 b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+inline float Vec2Distance(Vec2 a, Vec2 b) { return std::sqrt(Vec2DistanceSqr(a, b)); }
+
+// Circle vs axis-aligned rectangle (x, y, w, h)
+inline bool CircleIntersectsRect(Vec2 center, float radius, float x, float y, float w, float h) {
+    float closestX = center.x < x ? x : (center.x > x + w ? x + w : center.x);
+    float closestY = center.y < y ? y : (center.y > y + h ? y + h : center.y);
+    float dx = center.x - closestX;
+    float dy = center.y - closestY;
+    return (dx * dx + dy * dy) <= (radius * radius);
+}
@@ -2,34 +2,15 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
-#include <map>
+#include <cstdint>
+#include <unordered_set>
 #include "Config.hpp"
 #include "Brain.hpp"
+#include "InnovationRegistry.hpp"
 
 // Forward declarations
 struct Genome;
 
-// --- Innovation Tracking ---
-// Keeps track of global innovations to align historical markings
-class InnovationCounter {
-public:
-    static int GetInnovation(int inNode, int outNode) {
-        static int currentInnovation = 0;
-        static std::map<std::pair<int, int>, int> history;
-        
-        std::pair<int, int> connection = {inNode, outNode};
-        if (history.find(connection) == history.end()) {
-            history[connection] = ++currentInnovation;
-        }
-        return history[connection];
-    }
-    
-    static int GetNextNodeId() {
-        static int currentNodeId = 1000; // Start high to avoid conflict with initial sensor/output ids
-        return ++currentNodeId;
-    }
-};
-
 // --- Gene Structures ---
 
 enum class NodeType { Sensor, Hidden, Output };
@@ -43,9 +24,7 @@ struct NodeGene {
     float x = 0.0f; 
     float y = 0.0f;
     
-    explicit NodeGene(int _id, NodeType _t) : id(_id), type(_t) {
-        bias = RandomFloat(-3.0f, 3.0f);
-    }
+    NodeGene(int _id, NodeType _t, float _bias) : id(_id), type(_t), bias(_bias) {}
     
     NodeGene(const NodeGene& other) = default;
 };
@@ -63,21 +42,40 @@ struct ConnectionGene {
 
 // --- Genome ---
 
+// Invariants, kept by every operation below: `nodes` is sorted by id and
+// `connections` by innovation, both without duplicates. Lookups by id are
+// binary searches and crossover is a single merge of the parents' genes.
 struct Genome {
     std::vector<NodeGene> nodes;
     std::vector<ConnectionGene> connections;
     int layers = 2; // For drawing optimization
     
     Genome() = default;
+
+    const NodeGene* FindNode(int id) const {
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), id, [](const NodeGene& n, int v) { return n.id < v; });
+        return it != nodes.end() && it->id == id ? &*it : nullptr;
+    }
+
+    void InsertNode(const NodeGene& node) {
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), node.id, [](const NodeGene& n, int v) { return n.id < v; });
+        nodes.insert(it, node);
+    }
+
+    void InsertConnection(const ConnectionGene& con) {
+        auto it = std::lower_bound(connections.begin(), connections.end(), con.innovation,
+                                   [](const ConnectionGene& c, int v) { return c.innovation < v; });
+        connections.insert(it, con);
+    }
     
     // Initialize standard fully connected feed-forward (or empty)
-    void Initialize(int inputs, int outputs) {
+    void Initialize(int inputs, int outputs, Rng& rng, InnovationRegistry& innovations) {
         nodes.clear();
         connections.clear();
         
         // Add Input Nodes
         for(int i=0; i<inputs; ++i) {
-            NodeGene n(i, NodeType::Sensor);
+            NodeGene n(i, NodeType::Sensor, RandomFloat(rng, -3.0f, 3.0f));
             n.x = 0.1f;
             n.y = (float)(i + 1) / (inputs + 1);
             nodes.push_back(n);
@@ -85,51 +83,61 @@ struct Genome {
         
         // Add Output Nodes
         for(int i=0; i<outputs; ++i) {
-            NodeGene n(inputs + i, NodeType::Output); // IDs continue after inputs
+            NodeGene n(inputs + i, NodeType::Output, RandomFloat(rng, -3.0f, 3.0f)); // IDs continue after inputs
             n.x = 0.9f;
             n.y = (float)(i + 1) / (outputs + 1);
             nodes.push_back(n);
         }
         
         // Initial connections (Fully connected? Or sparse?)
+        // Their innovations grow with (i, j), so appending keeps them sorted
         // Let's start with sparse - 30% density
         for(int i=0; i<inputs; ++i) {
             for(int j=0; j<outputs; ++j) {
-                if(RandomFloat(0,1) < 0.5f) { // 50% density
+                if(RandomFloat(rng, 0,1) < 0.5f) { // 50% density
                     int inId = i;
                     int outId = inputs + j;
-                    int innov = InnovationCounter::GetInnovation(inId, outId);
-                    connections.emplace_back(inId, outId, RandomFloat(-2.0f, 2.0f), true, innov);
+                    int innov = innovations.Connection(inId, outId);
+                    connections.emplace_back(inId, outId, RandomFloat(rng, -2.0f, 2.0f), true, innov);
                 }
             }
         }
     }
     
     // --- Mutations ---
+    // MutateWeight only touches link weights. The structural mutations
+    // return whether they changed the graph, so brains know when a
+    // recompile is due.
     
-    void MutateWeight(float rate, float power) {
+    void MutateWeight(float rate, float power, Rng& rng) {
         for(auto& con : connections) {
-            if(RandomFloat(0,1) < rate) {
-                if(RandomFloat(0,1) < 0.1f) {
-                    con.weight = RandomFloat(-3.0f, 3.0f); // New random weight
+            if(RandomFloat(rng, 0,1) < rate) {
+                if(RandomFloat(rng, 0,1) < 0.1f) {
+                    con.weight = RandomFloat(rng, -3.0f, 3.0f); // New random weight
                 } else {
-                    con.weight += RandomFloat(-power, power); // Slight nudge
+                    con.weight += RandomFloat(rng, -power, power); // Slight nudge
                 }
                 con.weight = std::clamp(con.weight, -10.0f, 10.0f);
             }
         }
     }
     
-    void MutateAddConnection(float rate) {
-        if(RandomFloat(0,1) > rate) return;
+    bool MutateAddConnection(float rate, Rng& rng, InnovationRegistry& innovations) {
+        if(RandomFloat(rng, 0,1) > rate) return false;
         
         // Try to find two nodes to connect
-        if(nodes.empty()) return;
+        if(nodes.empty()) return false;
+        
+        // Existing links by packed (in, out) pair; built on the first
+        // candidate that passes the cheap checks
+        std::unordered_set<uint64_t> linked;
+        bool linkedBuilt = false;
+        auto key = [](int in, int out) { return ((uint64_t)(uint32_t)in << 32) | (uint32_t)out; };
         
         int attempts = 20;
         while(attempts-- > 0) {
-            int idx1 = (int)RandomFloat(0, nodes.size());
-            int idx2 = (int)RandomFloat(0, nodes.size());
+            int idx1 = rng.Index((int)nodes.size());
+            int idx2 = rng.Index((int)nodes.size());
             
             NodeGene& n1 = nodes[idx1];
             NodeGene& n2 = nodes[idx2];
@@ -147,133 +155,100 @@ struct Genome {
              // For sim stability, let's enforce non-recurrent for now:
             if(n1.x >= n2.x) continue; 
             
-            bool exists = false;
-            for(const auto& con : connections) {
-                if(con.inNode == n1.id && con.outNode == n2.id) {
-                    exists = true; break;
-                }
+            if(!linkedBuilt) {
+                linked.reserve(connections.size());
+                for(const auto& con : connections) linked.insert(key(con.inNode, con.outNode));
+                linkedBuilt = true;
             }
             
-            if(!exists) {
-                int innov = InnovationCounter::GetInnovation(n1.id, n2.id);
-                connections.emplace_back(n1.id, n2.id, RandomFloat(-2.0f, 2.0f), true, innov);
-                return;
+            if(!linked.count(key(n1.id, n2.id))) {
+                int innov = innovations.Connection(n1.id, n2.id);
+                InsertConnection(ConnectionGene(n1.id, n2.id, RandomFloat(rng, -2.0f, 2.0f), true, innov));
+                return true;
             }
         }
+        return false;
     }
     
-    void MutateAddNode(float rate) {
-         if(RandomFloat(0,1) > rate) return;
-         if(connections.empty()) return;
+    bool MutateAddNode(float rate, Rng& rng, InnovationRegistry& innovations) {
+         if(RandomFloat(rng, 0,1) > rate) return false;
+         if(connections.empty()) return false;
          
          // Pick random enabled connection
          int conIdx = -1;
          int attempts = 10;
          while(attempts-- > 0) {
-             int idx = (int)RandomFloat(0, connections.size());
+             int idx = rng.Index((int)connections.size());
              if(connections[idx].enabled) {
                  conIdx = idx;
                  break;
              }
          }
          
-         if(conIdx == -1) return;
+         if(conIdx == -1) return false;
          
          ConnectionGene& con = connections[conIdx];
-         con.enabled = false; // Disable old connection
-         
          int inNodeId = con.inNode;
          int outNodeId = con.outNode;
+         float oldWeight = con.weight; // `con` dangles once connections grow
          
-         // New Node
-         int newNodeId = InnovationCounter::GetNextNodeId();
-         NodeGene newNode(newNodeId, NodeType::Hidden);
+         // New Node. Splitting the same link twice in a generation yields the
+         // same id, which this genome may already carry (the link came back
+         // enabled through crossover); then there is nothing new to add.
+         int newNodeId = innovations.SplitNode(inNodeId, outNodeId);
+         if(FindNode(newNodeId)) return false;
+         con.enabled = false; // Disable old connection
+         NodeGene newNode(newNodeId, NodeType::Hidden, RandomFloat(rng, -3.0f, 3.0f));
          
          // Position logic (for drawing)
-         // Find inNode and outNode objects to get x/y
-         // Optimized: just scan list once (slow but clear)
          float inX=0, inY=0, outX=1, outY=1;
-         for(auto& n : nodes) { if(n.id == inNodeId) {inX=n.x; inY=n.y;} if(n.id == outNodeId) {outX=n.x; outY=n.y;} }
+         if(const NodeGene* n = FindNode(inNodeId)) { inX = n->x; inY = n->y; }
+         if(const NodeGene* n = FindNode(outNodeId)) { outX = n->x; outY = n->y; }
          
          newNode.x = (inX + outX) / 2.0f;
-         newNode.y = (inY + outY) / 2.0f + RandomFloat(-0.1f, 0.1f);
-         nodes.push_back(newNode);
+         newNode.y = (inY + outY) / 2.0f + RandomFloat(rng, -0.1f, 0.1f);
+         InsertNode(newNode);
          
          // Two new connections
          // 1. In -> New (Weight = 1.0)
-         int innov1 = InnovationCounter::GetInnovation(inNodeId, newNodeId);
-         connections.emplace_back(inNodeId, newNodeId, 1.0f, true, innov1);
+         int innov1 = innovations.Connection(inNodeId, newNodeId);
+         InsertConnection(ConnectionGene(inNodeId, newNodeId, 1.0f, true, innov1));
          
          // 2. New -> Out (Weight = OldWeight)
-         int innov2 = InnovationCounter::GetInnovation(newNodeId, outNodeId);
-         connections.emplace_back(newNodeId, outNodeId, con.weight, true, innov2);
+         int innov2 = innovations.Connection(newNodeId, outNodeId);
+         InsertConnection(ConnectionGene(newNodeId, outNodeId, oldWeight, true, innov2));
+         return true;
     }
     
     // --- Crossover ---
-    static Genome Crossover(const Genome& mom, const Genome& dad) {
+    // Mom is taken to be the fitter parent: matching genes come from either
+    // at random, disjoint and excess genes only from mom. Both gene lists
+    // are already in innovation order, so this is one merge pass.
+    static Genome Crossover(const Genome& mom, const Genome& dad, Rng& rng) {
         Genome baby;
-        baby.nodes = mom.nodes; // Inherit nodes (topologically, usually from most fit. Assuming mom is more fit or equal)
-        // Note: Real NEAT node inheritance is complex. Simplification: Inherit nodes from fit parent.
-        
-        // Matching genes
-        auto& momGenes = mom.connections;
-        auto& dadGenes = dad.connections; // Assuming const ref
-        
-        // Use maps for O(N) alignment (or just loop since genomes are small)
-        // Rely on innovation numbers
-        
-        // We iterate through all innovations found in both
-        size_t m=0, d=0;
-        // Sort first? connections should be chronological usually, but let's sort to be safe
-        std::vector<ConnectionGene> mSorted = momGenes;
-        std::vector<ConnectionGene> dSorted = dadGenes;
-        std::sort(mSorted.begin(), mSorted.end(), [](auto& a, auto& b){ return a.innovation < b.innovation; });
-        std::sort(dSorted.begin(), dSorted.end(), [](auto& a, auto& b){ return a.innovation < b.innovation; });
-        
-        // Assume mom is fitter (or same). Disjoint/Excess genes from mom are inherited.
-        // Disjoint/Excess from dad are discarded (unless equal fitness - tricky).
+        baby.nodes = mom.nodes;
+        baby.connections.reserve(mom.connections.size());
         
-        while(m < mSorted.size() && d < dSorted.size()) {
-            if(mSorted[m].innovation == dSorted[d].innovation) {
-                // Matching
-                ConnectionGene gene = (rand()%2) ? mSorted[m] : dSorted[d];
-                baby.connections.push_back(gene);
-                m++; d++;
-            } else if(mSorted[m].innovation < dSorted[d].innovation) {
-                // Disjoint in Mom
-                baby.connections.push_back(mSorted[m]);
-                m++;
+        const auto& m = mom.connections;
+        const auto& d = dad.connections;
+        size_t j = 0;
+        for(const auto& gene : m) {
+            while(j < d.size() && d[j].innovation < gene.innovation) j++; // Disjoint in dad: dropped
+            if(j < d.size() && d[j].innovation == gene.innovation) {
+                baby.connections.push_back(rng.Coin() ? gene : d[j]);
+                j++;
             } else {
-                // Disjoint in Dad - discard (assuming Mom is fitter) 
-                d++;
+                baby.connections.push_back(gene);
             }
         }
         
-        // Excess in Mom
-        while(m < mSorted.size()) {
-            baby.connections.push_back(mSorted[m]);
-            m++;
-        }
-        
-        // Validate Nodes: The specific nodes referenced by connections must exist in baby.nodes.
-        // Simplified: Baby copies Mom's nodes. If Dad had disjoint connections with *new* nodes, 
-        // we might have dangling connections if we just copy Mom's nodes.
-        // Handling this properly requires union of nodes or inheriting nodes from the parent acting as source for connections.
-        // Fix: Add any missing nodes referenced by inherited connections.
-        
+        // A matching gene names the same link in both parents, so every
+        // endpoint is normally one of mom's nodes. Anything missing (a
+        // malformed parent) is taken from dad.
         for(const auto& con : baby.connections) {
-            bool inFound = false;
-            bool outFound = false;
-            for(const auto& n : baby.nodes) {
-                if(n.id == con.inNode) inFound = true;
-                if(n.id == con.outNode) outFound = true;
-            }
-            if(!inFound) {
-                 // Fetch node from parents... slow
-                 for(const auto& n : dad.nodes) if(n.id == con.inNode) baby.nodes.push_back(n); // Copy from dad
-            }
-            if(!outFound) {
-                 for(const auto& n : dad.nodes) if(n.id == con.outNode) baby.nodes.push_back(n);
+            for(int id : {con.inNode, con.outNode}) {
+                if(baby.FindNode(id)) continue;
+                if(const NodeGene* n = dad.FindNode(id)) baby.InsertNode(*n);
             }
         }
         
@@ -1,3 +1,4 @@
+#pragma once
 #include "Brain.hpp"
 #include <string>
 
@@ -10,20 +11,23 @@ struct NeuralNetwork : public IBrain {
     std::vector<float> cachedHidden;
     std::vector<float> cachedOutput;
 
-    NeuralNetwork(int inp, int hid, int out);
+    // LearnFromReward scratch
+    std::vector<float> outputGradients;
+    std::vector<float> hiddenGradients;
+
+    NeuralNetwork(int inp, int hid, int out, Rng& rng);
 
     // IBrain implementation
-    std::vector<float> FeedForward(const std::vector<float>& inputs) override;
-    void Mutate(float rate, float strength) override;
-    std::unique_ptr<IBrain> Crossover(const IBrain& other) const override;
+    void FeedForward(std::span<const float> inputs, std::span<float> outputs) override;
+    void Mutate(float rate, float strength, Rng& rng) override;
+    std::unique_ptr<IBrain> Crossover(const IBrain& other, Rng& rng) const override;
     std::unique_ptr<IBrain> Clone() const override;
     void LearnFromReward(float reward, float learningRate) override;
-    void Draw(ImVec2 pos, ImVec2 size) override;
     
     int GetInputSize() const override { return inputSize; }
     int GetOutputSize() const override { return outputSize; }
     std::string GetType() const override { return "FeedForwardNN"; }
 
     // Static helper for legacy/direct usage if needed, though Crossover override handles dispatch
-    static NeuralNetwork CrossoverStatic(const NeuralNetwork& a, const NeuralNetwork& b);
+    static NeuralNetwork CrossoverStatic(const NeuralNetwork& a, const NeuralNetwork& b, Rng& rng);
 };
\ No newline at end of file
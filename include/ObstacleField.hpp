@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include "Entities.hpp"
+
+// Signed distance field over the map, baked whenever the obstacles change.
+// Nodes sit every `cellSize` pixels; each stores the signed distance to the
+// nearest obstacle surface (negative inside) and the unit gradient, which
+// points away from that surface. Lookups are bilinear, so collision and the
+// obstacle sensor cost the same whatever the obstacle count.
+//
+// Only a narrow band around the obstacles is stored. Nodes live in square
+// tiles, and a tile is baked only when an obstacle lies within `band` of it;
+// everywhere else the field reads as `band` with no gradient. Distances below
+// the band are exact, so callers just keep the band above their query range.
+class ObstacleField {
+public:
+    struct Sample {
+        float distance;
+        Vec2 gradient;
+    };
+
+    // Exact Euclidean distance transform of the obstacle occupancy, O(baked nodes)
+    void Bake(const std::vector<Obstacle>& obstacles, int width, int height, float cellSize, float band);
+
+    float Distance(Vec2 p) const;
+    Sample Lookup(Vec2 p) const;
+
+    bool Matches(int width, int height, float cellSize, float bandWidth) const {
+        return width == mapW && height == mapH && cellSize == cell && bandWidth == band;
+    }
+    int NodesX() const { return nx; }
+    int NodesY() const { return ny; }
+    int BakedTiles() const { return (int)(texels.size() / TILE_TEXELS); }
+
+private:
+    // A tile covers TILE x TILE cells; it stores one extra row and column of
+    // nodes so every bilinear lookup stays inside a single tile
+    static constexpr int TILE = 32;
+    static constexpr int TILE_STRIDE = TILE + 1;
+    static constexpr int TILE_TEXELS = TILE_STRIDE * TILE_STRIDE;
+    // Tiles are baked in blocks of this many per side, which bounds the scratch
+    // buffers while keeping the padding overhead small
+    static constexpr int BLOCK_TILES = 24;
+
+    struct Texel {
+        float d;
+        float gx, gy;
+    };
+
+    // Bakes nodes [x0, x0 + w) x [y0, y0 + h) into out, row-major
+    void BakeRegion(const std::vector<Obstacle>& obstacles, int x0, int y0, int w, int h, std::vector<Texel>& out) const;
+    // Top-left texel of p's bilinear cell and the weights, or nullptr beyond the band
+    const Texel* Locate(Vec2 p, float& tx, float& ty) const;
+
+    int mapW = 0, mapH = 0;
+    float cell = 0.0f, invCell = 0.0f, band = 0.0f;
+    int nx = 0, ny = 0;
+    int tilesX = 0, tilesY = 0;
+    std::vector<int> tileSlot;   // Row-major tile table: block index in texels, -1 if not baked
+    std::vector<Texel> texels;   // TILE_TEXELS per baked tile, row-major inside the tile
+};
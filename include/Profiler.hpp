@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Per-phase tick profiler.
+// World::Update wraps each phase in MC_PROFILE_SCOPE; the timings are summed
+// per tick and kept in a ring buffer for the UI and the headless CSV dump.
+// Build with MICROCOSM_PROFILING=0 to compile every scope out.
+#ifndef MICROCOSM_PROFILING
+#define MICROCOSM_PROFILING 1
+#endif
+
+enum class ProfPhase : int {
+    Seasons,
+    GridRebuild,
+    Agents,      // Whole per-agent loop; Sense/Think/Interact are nested inside it
+    Sense,
+    Think,
+    Interact,
+    Births,
+    Cleanup,
+    Respawn,
+    Generation,
+    Count
+};
+
+constexpr int PROF_PHASE_COUNT = (int)ProfPhase::Count;
+
+const char* GetPhaseName(ProfPhase phase);
+
+struct TickProfile {
+    std::array<float, PROF_PHASE_COUNT> ms{}; // Inclusive milliseconds per phase
+    float totalMs = 0.0f;
+    int agentCount = 0;
+
+    // Agent-loop time not covered by the nested Sense/Think/Interact scopes
+    float AgentOtherMs() const {
+        float nested = ms[(int)ProfPhase::Sense] + ms[(int)ProfPhase::Think] + ms[(int)ProfPhase::Interact];
+        float other = ms[(int)ProfPhase::Agents] - nested;
+        return other > 0.0f ? other : 0.0f;
+    }
+};
+
+class TickProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int HISTORY_SIZE = 600;
+
+    // The ring buffer is allocated up front so ticks never grow it
+    TickProfiler() { history.reserve(HISTORY_SIZE); }
+
+    void BeginTick() {
+        current = {};
+        tickStart = Clock::now();
+    }
+
+    void EndTick(int agentCount) {
+        current.totalMs = ToMs(Clock::now() - tickStart);
+        current.agentCount = agentCount;
+        if ((int)history.size() < HISTORY_SIZE) history.push_back(current);
+        else history[head] = current;
+        head = (head + 1) % HISTORY_SIZE;
+        ++tickCount;
+    }
+
+    void Add(ProfPhase phase, Clock::duration elapsed) {
+        current.ms[(int)phase] += ToMs(elapsed);
+    }
+
+    // Oldest-first access to the ring buffer
+    int Size() const { return (int)history.size(); }
+    const TickProfile& At(int i) const {
+        int start = (int)history.size() < HISTORY_SIZE ? 0 : head;
+        return history[(start + i) % HISTORY_SIZE];
+    }
+    const TickProfile* Last() const { return history.empty() ? nullptr : &At(Size() - 1); }
+    long long TickCount() const { return tickCount; }
+
+    static bool Enabled() { return MICROCOSM_PROFILING != 0; }
+
+    static void WriteCsvHeader(std::FILE* f);
+    static void WriteCsvRow(std::FILE* f, long long tick, const TickProfile& p);
+
+private:
+    static float ToMs(Clock::duration d) { return std::chrono::duration<float, std::milli>(d).count(); }
+
+    std::vector<TickProfile> history;
+    int head = 0;
+    long long tickCount = 0;
+    TickProfile current;
+    Clock::time_point tickStart;
+};
+
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(TickProfiler& p, ProfPhase ph) : profiler(p), phase(ph), start(TickProfiler::Clock::now()) {}
+    ~ScopedPhaseTimer() { profiler.Add(phase, TickProfiler::Clock::now() - start); }
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    TickProfiler& profiler;
+    ProfPhase phase;
+    TickProfiler::Clock::time_point start;
+};
+
+#define MC_PROFILE_CONCAT_INNER(a, b) a##b
+#define MC_PROFILE_CONCAT(a, b) MC_PROFILE_CONCAT_INNER(a, b)
+
+#if MICROCOSM_PROFILING
+#define MC_PROFILE_SCOPE(profiler, phase) ScopedPhaseTimer MC_PROFILE_CONCAT(mcProfScope, __LINE__)(profiler, phase)
+#else
+#define MC_PROFILE_SCOPE(profiler, phase) ((void)0)
+#endif
@@ -5,26 +5,28 @@
 struct RNNBrain : public IBrain {
     int inputSize, hiddenSize, outputSize;
     
-    // Weights
-    std::vector<float> inputWeights;  // Input -> Hidden
-    std::vector<float> recurrentWeights; // Hidden(t-1) -> Hidden(t)
+    // Weights. Each step is one mat-vec against the concatenation
+    // [input(t), hidden(t-1)]: stepWeights is that combined matrix stored
+    // column by column (entry k*hiddenSize + h feeds step entry k into
+    // hidden unit h), so the product runs across hidden units.
+    std::vector<float> stepWeights;   // (Input + Hidden(t-1)) -> Hidden(t)
     std::vector<float> outputWeights; // Hidden -> Output
     std::vector<float> biases; // For Hidden layer
     
-    // State
-    std::vector<float> hiddenState; // Current hidden state
-    std::vector<float> nextHidden;  // Workspace for calculations
-    std::vector<float> cachedInputs; // For visual/debug
+    // State. Two step vectors [input | hidden], used alternately: a step
+    // reads the current one and writes the new hidden state straight into
+    // the tail of the other, so nothing is copied between ticks.
+    std::vector<float> steps[2];
+    int current = 0;
 
-    RNNBrain(int inp, int hid, int out);
+    RNNBrain(int inp, int hid, int out, Rng& rng);
 
     // IBrain implementation
-    std::vector<float> FeedForward(const std::vector<float>& inputs) override;
-    void Mutate(float rate, float strength) override;
-    std::unique_ptr<IBrain> Crossover(const IBrain& other) const override;
+    void FeedForward(std::span<const float> inputs, std::span<float> outputs) override;
+    void Mutate(float rate, float strength, Rng& rng) override;
+    std::unique_ptr<IBrain> Crossover(const IBrain& other, Rng& rng) const override;
     std::unique_ptr<IBrain> Clone() const override;
     void LearnFromReward(float reward, float learningRate) override; // Simplified for now
-    void Draw(ImVec2 pos, ImVec2 size) override;
     
     int GetInputSize() const override { return inputSize; }
     int GetOutputSize() const override { return outputSize; }
@@ -32,6 +34,10 @@ struct RNNBrain : public IBrain {
     
     void ResetState();
 
+    float InputWeight(int h, int i) const { return stepWeights[(size_t)i * hiddenSize + h]; }
+    std::span<const float> HiddenState() const { return {steps[current].data() + inputSize, (size_t)hiddenSize}; }
+    std::span<const float> LastInputs() const { return {steps[current ^ 1].data(), (size_t)inputSize}; } // For visual/debug
+
 private:
-    static RNNBrain CrossoverStatic(const RNNBrain& a, const RNNBrain& b);
+    static RNNBrain CrossoverStatic(const RNNBrain& a, const RNNBrain& b, Rng& rng);
 };
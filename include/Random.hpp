@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <limits>
+
+// Seedable xoshiro256** generator.
+// Every random draw in the simulation goes through an Rng that is owned by a
+// World (or split off from it), so a run is fully determined by its seed.
+// Split() hands out non-overlapping substreams via the 2^128 jump polynomial,
+// which is how agents (and later worker threads) get their own streams
+// without sharing state.
+class Rng {
+public:
+    using result_type = uint64_t;
+
+    explicit Rng(uint64_t seed = 0x9E3779B97F4A7C15ull) { Seed(seed); }
+
+    void Seed(uint64_t seed) {
+        // SplitMix64 expands the seed so that similar seeds give unrelated states
+        for (auto& word : s) {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() { return Next(); }
+
+    uint64_t Next() {
+        const uint64_t result = Rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 45);
+        return result;
+    }
+
+    // Advances the stream by 2^128 draws
+    void Jump() {
+        static constexpr uint64_t JUMP[] = {
+            0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+            0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+        };
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t mask : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (mask & (1ull << b)) {
+                    t[0] ^= s[0]; t[1] ^= s[1]; t[2] ^= s[2]; t[3] ^= s[3];
+                }
+                Next();
+            }
+        }
+        s[0] = t[0]; s[1] = t[1]; s[2] = t[2]; s[3] = t[3];
+    }
+
+    // Returns an independent substream and moves this stream past it
+    Rng Split() {
+        Rng child = *this;
+        Jump();
+        return child;
+    }
+
+    // [0, 1)
+    float Float01() { return (float)(Next() >> 40) * (1.0f / 16777216.0f); }
+
+    // [min, max)
+    float Range(float lo, float hi) { return lo + (hi - lo) * Float01(); }
+
+    // [0, n)
+    int Index(int n) { return n > 0 ? (int)((Next() >> 32) * (uint64_t)n >> 32) : 0; }
+
+    bool Coin() { return (Next() >> 63) != 0; }
+
+    // Box-Muller; implemented here so results do not depend on the standard library
+    float Normal(float mean, float stddev) {
+        float u1 = Float01();
+        float u2 = Float01();
+        if (u1 < 1e-7f) u1 = 1e-7f;
+        float mag = std::sqrt(-2.0f * std::log(u1));
+        return mean + stddev * mag * std::cos(6.28318530718f * u2);
+    }
+
+private:
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
+
+inline float RandomFloat(Rng& rng, float min, float max) {
+    return rng.Range(min, max);
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "raylib.h"
+#include "World.hpp"
+
+// raylib-side drawing for the simulation core types.
+// Nothing in here is linked into microcosm_core.
+
+inline Vector2 ToRaylib(Vec2 v) { return {v.x, v.y}; }
+inline Vec2 FromRaylib(Vector2 v) { return {v.x, v.y}; }
+inline Color ToRaylib(Tint t) { return {t.r, t.g, t.b, t.a}; }
+
+void DrawObstacle(const Obstacle& obs);
+// Draws what the camera can see, plus the world border.
+// alpha in [0,1] interpolates agents between their previous and current tick
+void DrawWorld(const World& world, const Camera2D& camera, float alpha = 1.0f);
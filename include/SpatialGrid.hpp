@@ -0,0 +1,320 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include "Config.hpp"
+
+// One entity layer of the spatial grid. A layer is in one of two modes:
+//
+// Batch: compressed-sparse-row. Entries for cell c live in
+// [cellStart[c], cellStart[c + 1]) of `indices`/`positions`. Items are staged
+// with Add() and sorted into place by Build(); every buffer keeps its
+// capacity, so a steady-state rebuild does not allocate.
+//
+// Linked: an intrusive doubly linked list per cell over flat arrays indexed by
+// entity index. Entities are appended, moved and removed one at a time, so
+// keeping the layer current costs O(changes) instead of O(population).
+// SwapRemove() follows a swap-and-pop of the entity array.
+//
+// Per-cell storage is paged: cells are grouped into pages of PAGE_CELLS
+// consecutive indices and a page only gets storage once something lands in
+// it, so empty regions of a large world cost one page-table entry.
+class GridLayer {
+public:
+    static constexpr int PAGE_SHIFT = 6;
+    static constexpr int PAGE_CELLS = 1 << PAGE_SHIFT;
+
+    // --- Batch mode ---
+    void Reset(int numCells);
+    void Add(int cell, int index, Vec2 pos) {
+        stagedCell.push_back(cell);
+        stagedIndex.push_back(index);
+        stagedPos.push_back(pos);
+    }
+    void Build();
+
+    // --- Linked mode ---
+    void ResetLinked(int numCells);
+    // Tracks entity Tracked(); cell -1 keeps it unlinked (off-grid)
+    void Append(int cell, Vec2 pos);
+    void Move(int index, int cell, Vec2 pos);
+    void Remove(int index) { Move(index, -1, entityPos[index]); }
+    // Drops entity `index` and moves the last tracked entity into its place
+    void SwapRemove(int index);
+    int Tracked() const { return (int)cellOf.size(); }
+    int CellOfEntity(int index) const { return cellOf[index]; }
+
+    bool Linked() const { return linked; }
+    int NumCells() const { return numCells; }
+    int AllocatedPages() const { return usedPages; }
+
+    // Calls fn(index, pos) for every entry of `cell`. If fn returns bool,
+    // returning false stops the walk and ForEach returns false.
+    template <typename F>
+    bool ForEach(int cell, F&& fn) const {
+        int slot = Slot(cell);
+        if (slot < 0) return true;
+        if (linked) {
+            for (int i = head[slot]; i >= 0; i = next[i]) {
+                if (!Visit(fn, i, entityPos[i])) return false;
+            }
+        } else {
+            for (int k = cellStart[slot]; k < cellStart[slot + 1]; ++k) {
+                if (!Visit(fn, indices[k], positions[k])) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    template <typename F>
+    static bool Visit(F& fn, int index, Vec2 pos) {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, int, Vec2>>) {
+            fn(index, pos);
+            return true;
+        } else {
+            return fn(index, pos);
+        }
+    }
+
+    // Storage slot of a cell, or -1 when its page holds nothing
+    int Slot(int cell) const {
+        int page = pageSlot[cell >> PAGE_SHIFT];
+        return page < 0 ? -1 : (page << PAGE_SHIFT) | (cell & (PAGE_CELLS - 1));
+    }
+    int SlotOrAllocate(int cell);
+    void ResetPages(int cells);
+
+    void Link(int index, int cell);
+    void Unlink(int index);
+
+    bool linked = false;
+    int numCells = 0;
+    int usedPages = 0;
+    std::vector<int> pageSlot;    // Per page: index of its storage block, -1 if unallocated
+
+    // Batch
+    std::vector<int> cellStart;   // Per slot, plus one: offsets into indices/positions
+    std::vector<int> indices;
+    std::vector<Vec2> positions;
+
+    std::vector<int> stagedCell;
+    std::vector<int> stagedIndex;
+    std::vector<Vec2> stagedPos;
+
+    // Linked
+    std::vector<int> head;        // Per slot: first entity of the cell, -1 if empty
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> cellOf;      // -1 when not linked into any cell
+    std::vector<Vec2> entityPos;
+};
+
+struct NearestHit {
+    int index = -1;     // -1 when nothing was found
+    Vec2 pos = {};      // Entry position; for wrapped queries, its image nearest the query point
+    float distSqr = 0.0f;
+};
+
+struct SpatialGrid {
+    // Cells are numbered by 8x8 block (one GridLayer page), then by x and y
+    // inside the block, so a neighbourhood touches few pages
+    GridLayer fruits;
+    GridLayer poisons;
+    GridLayer agents;
+    GridLayer obstacles;        // Every cell an obstacle's bounds overlap (collision)
+    GridLayer obstacleCenters;  // Only the cell holding its centre (sensing)
+
+    void Clear();
+    void AddFruit(int index, Vec2 pos);
+    void AddPoison(int index, Vec2 pos);
+    void AddAgent(int index, Vec2 pos);
+    void AddObstacle(int index, Vec2 pos, Vec2 size);
+    void Build();
+
+    // Sets the nominal cell size and covered map. Cells are stretched so a
+    // whole number of them spans the map exactly, which makes the grid tile
+    // the torus. Returns true when the geometry changed, in which case every
+    // layer must be refilled.
+    bool Configure(int cell, int mapW, int mapH);
+    int CellSize() const { return cellSize; }
+    int NumCells() const { return blocksW * blocksH * GridLayer::PAGE_CELLS; }
+
+    // Cell of a point, or -1 when it lies outside the map
+    int CellOf(Vec2 pos) const;
+
+    // Nearest entry of `layer` strictly within maxDist of p that `accept(index)`
+    // allows. Cells are searched in rings of growing Chebyshev radius around
+    // p's cell, and the search stops as soon as the next ring cannot hold
+    // anything closer than the best candidate, so dense neighbourhoods are
+    // cheap whatever maxDist is. Ties go to the lowest index, which makes the
+    // result independent of the visiting order.
+    template <typename Accept>
+    NearestHit Nearest(const GridLayer& layer, Vec2 p, float maxDist, Accept&& accept) const {
+        return NearestImpl<false>(layer, p, maxDist, accept);
+    }
+
+    // Calls fn(index, pos) for entries of the cells overlapping the disc
+    // around p; callers still test the exact distance. Like GridLayer::ForEach,
+    // a bool-returning fn can stop the walk early.
+    template <typename F>
+    bool ForEachInRadius(const GridLayer& layer, Vec2 p, float radius, F&& fn) const {
+        return ForEachInRadiusImpl<false>(layer, p, radius, [&](int idx, Vec2 pos, Vec2) { return fn(idx, pos); });
+    }
+
+    // Toroidal versions for the entity layers, matching the agents' wrap at
+    // the map edges. Cells past an edge resolve through precomputed tables to
+    // the real cell on the other side plus the offset that carries its entries
+    // to their image nearest p, so distances are minimal-image with no
+    // per-candidate branching. fn gets (index, image position, offset); add
+    // the offset to any live position read from the entity itself. The radius
+    // must stay under half the map size.
+    template <typename Accept>
+    NearestHit NearestWrapped(const GridLayer& layer, Vec2 p, float maxDist, Accept&& accept) const {
+        return NearestImpl<true>(layer, p, maxDist, accept);
+    }
+    template <typename F>
+    bool ForEachInRadiusWrapped(const GridLayer& layer, Vec2 p, float radius, F&& fn) const {
+        return ForEachInRadiusImpl<true>(layer, p, radius, fn);
+    }
+
+    // Helper to get cell index safely
+    int GetCellIndex(int x, int y) const {
+        if (x < 0) x = 0; if (x >= gridW) x = gridW - 1;
+        if (y < 0) y = 0; if (y >= gridH) y = gridH - 1;
+        int block = (x >> BLOCK_SHIFT) * blocksH + (y >> BLOCK_SHIFT);
+        return (block << GridLayer::PAGE_SHIFT) | ((x & BLOCK_MASK) << BLOCK_SHIFT) | (y & BLOCK_MASK);
+    }
+
+private:
+    static constexpr int BLOCK_SHIFT = GridLayer::PAGE_SHIFT / 2;
+    static constexpr int BLOCK_MASK = (1 << BLOCK_SHIFT) - 1;
+
+    // One axis of the wrap tables: virtual column (or row) v in
+    // [-margin, n + margin) maps to the real one's share of the cell index and
+    // the shift that moves its entries next to v
+    struct WrapAxis {
+        std::vector<int> cellPart;
+        std::vector<float> offset;
+        int margin = 0;
+    };
+
+    int Column(float x) const { return std::clamp((int)(x * invCellW), 0, gridW - 1); }
+    int Row(float y) const { return std::clamp((int)(y * invCellH), 0, gridH - 1); }
+
+    // Visits virtual cell (x, y). Bounded queries skip cells off the map;
+    // wrapped ones resolve them through the tables.
+    template <bool Wrap, typename F>
+    bool VisitCell(const GridLayer& layer, int x, int y, F& fn) const {
+        if constexpr (Wrap) {
+            int vx = x + wrapX.margin, vy = y + wrapY.margin;
+            Vec2 offset = {wrapX.offset[vx], wrapY.offset[vy]};
+            return layer.ForEach(wrapX.cellPart[vx] + wrapY.cellPart[vy], [&](int idx, Vec2 pos) {
+                return Visit(fn, idx, Vec2Add(pos, offset), offset);
+            });
+        } else {
+            if (x < 0 || x >= gridW || y < 0 || y >= gridH) return true;
+            return layer.ForEach(GetCellIndex(x, y), [&](int idx, Vec2 pos) {
+                return Visit(fn, idx, pos, Vec2{0.0f, 0.0f});
+            });
+        }
+    }
+
+    template <typename F>
+    static bool Visit(F& fn, int index, Vec2 pos, Vec2 offset) {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, int, Vec2, Vec2>>) {
+            fn(index, pos, offset);
+            return true;
+        } else {
+            return fn(index, pos, offset);
+        }
+    }
+
+    template <bool Wrap, typename Accept>
+    NearestHit NearestImpl(const GridLayer& layer, Vec2 p, float maxDist, Accept& accept) const {
+        NearestHit best;
+        best.distSqr = maxDist * maxDist;
+        int gx = Column(p.x);
+        int gy = Row(p.y);
+        int maxRing = (int)(maxDist * std::max(invCellW, invCellH)) + 1;
+
+        auto consider = [&](int idx, Vec2 pos, Vec2) {
+            float dSqr = Vec2DistanceSqr(p, pos);
+            if ((dSqr < best.distSqr || (dSqr == best.distSqr && best.index >= 0 && idx < best.index)) && accept(idx)) {
+                best.index = idx;
+                best.pos = pos;
+                best.distSqr = dSqr;
+            }
+        };
+
+        for (int r = 0; r <= maxRing; ++r) {
+            if (r > 0) {
+                // Rings 0..r-1 cover the box [gx-r+1, gx+r) x [gy-r+1, gy+r) in
+                // cells; ring r is at least as far away as that box's edge
+                float edge = std::min(std::min(p.x - (gx - r + 1) * cellW, (gx + r) * cellW - p.x),
+                                      std::min(p.y - (gy - r + 1) * cellH, (gy + r) * cellH - p.y));
+                if (edge > 0.0f && edge * edge > best.distSqr) break;
+                if constexpr (Wrap) {
+                    // The box already spans the whole torus
+                    if (2 * r - 1 >= gridW && 2 * r - 1 >= gridH) break;
+                } else {
+                    // Past every grid edge: nothing left to visit
+                    if (gx - r < 0 && gx + r >= gridW && gy - r < 0 && gy + r >= gridH) break;
+                }
+            }
+            if (r == 0) {
+                VisitCell<Wrap>(layer, gx, gy, consider);
+                continue;
+            }
+            for (int x = gx - r; x <= gx + r; ++x) {
+                VisitCell<Wrap>(layer, x, gy - r, consider);
+                VisitCell<Wrap>(layer, x, gy + r, consider);
+            }
+            for (int y = gy - r + 1; y <= gy + r - 1; ++y) {
+                VisitCell<Wrap>(layer, gx - r, y, consider);
+                VisitCell<Wrap>(layer, gx + r, y, consider);
+            }
+        }
+        return best;
+    }
+
+    template <bool Wrap, typename F>
+    bool ForEachInRadiusImpl(const GridLayer& layer, Vec2 p, float radius, F&& fn) const {
+        int x0 = (int)std::floor((p.x - radius) * invCellW);
+        int y0 = (int)std::floor((p.y - radius) * invCellH);
+        int x1 = (int)std::floor((p.x + radius) * invCellW);
+        int y1 = (int)std::floor((p.y + radius) * invCellH);
+        if constexpr (Wrap) {
+            // A real cell can be visited at both of its images; with a radius
+            // under half the map at most one of them is in range
+            x0 = std::max(x0, -wrapX.margin);
+            y0 = std::max(y0, -wrapY.margin);
+            x1 = std::min(x1, gridW + wrapX.margin - 1);
+            y1 = std::min(y1, gridH + wrapY.margin - 1);
+        } else {
+            x0 = std::max(0, x0);
+            y0 = std::max(0, y0);
+            x1 = std::min(gridW - 1, x1);
+            y1 = std::min(gridH - 1, y1);
+        }
+        for (int x = x0; x <= x1; ++x) {
+            for (int y = y0; y <= y1; ++y) {
+                if (!VisitCell<Wrap>(layer, x, y, fn)) return false;
+            }
+        }
+        return true;
+    }
+
+    void BuildWrapAxis(WrapAxis& axis, int n, float period, bool isColumn) const;
+
+    int cellSize = 50;
+    int gridW = 1;
+    int gridH = 1;
+    float mapW = 0.0f, mapH = 0.0f;
+    float cellW = 50.0f, cellH = 50.0f;
+    float invCellW = 1.0f / 50.0f, invCellH = 1.0f / 50.0f;
+    int blocksW = 1;
+    int blocksH = 1;
+    WrapAxis wrapX, wrapY;
+};
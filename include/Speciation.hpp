@@ -0,0 +1,43 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "NEATGenome.hpp"
+
+// NEAT compatibility distance (Stanley & Miikkulainen): excess and
+// disjoint gene counts, normalized by the larger genome, plus the mean
+// weight difference of matching genes. Both genomes keep their links in
+// innovation order, so this is one merge over the two lists.
+float CompatibilityDistance(const Genome& a, const Genome& b);
+
+// Groups genomes into species so a new topology only competes with its
+// own kind. Species live across generations: each keeps a copy of one
+// member from the last assignment as its representative, and a genome is
+// compared with the representatives only, joining the first within
+// Config::NEAT_COMPAT_THRESHOLD or founding a new species. Assignment is
+// O(genomes x species) distance merges.
+class Speciation {
+public:
+    struct Species {
+        int id;
+        Genome representative;
+        int members = 0;
+        float totalFitness = 0.0f;
+
+        float MeanFitness() const { return members > 0 ? totalFitness / members : 0.0f; }
+    };
+
+    // Writes each genome's index into Species() to speciesOf. Callers pass
+    // genomes fittest first: the first member of every species becomes its
+    // representative for the next call. Species left without members are
+    // dropped.
+    void Assign(std::span<const Genome* const> genomes, std::span<const float> fitness, std::vector<int>& speciesOf);
+    void Clear();
+
+    const std::vector<Species>& GetSpecies() const { return species; }
+
+private:
+    std::vector<Species> species;
+    std::vector<int> firstMember;   // Scratch: per species, its first genome this call
+    std::vector<int> remap;         // Scratch: old species index -> compacted index
+    int nextId = 0;
+};
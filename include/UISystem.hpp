@@ -5,20 +5,36 @@
 struct UIState {
     bool paused = false;
     float timeScale = 1.0f;
+    
+    // Fixed-step loop (see StepSimulation in main.cpp)
+    bool turbo = false;            // Run as many ticks as fit in turboBudgetMs per frame
+    float turboBudgetMs = 14.0f;
+    float tickAccumulator = 0.0f;  // Unsimulated time carried between frames
+    float renderAlpha = 1.0f;      // Interpolation factor between the last two ticks
+    int ticksLastFrame = 0;
+    float ticksPerSecond = 0.0f;
     bool godMode = false;
     bool showNeuralViz = false;
     bool showAgentStats = false;
     bool showPhenotypePanel = false;
     bool showAnalytics = false;
-    int selectedAgentIdx = -1;
+    bool showProfiler = false;
+    AgentId selectedAgent;         // Stays on the same agent while others die
     
     enum class SpawnTool { None, Fruit, Poison, Agent, AgentRNN, AgentNEAT, Erase };
     SpawnTool currentTool = SpawnTool::None;
     
     Camera2D camera = { 0 };
     bool freeCam = false;
+    int sizeSelection = (int)Config::CURRENT_SIZE;  // Combo choice; may be Custom before it is applied
+    int customWorldSize[2] = { 10000, 10000 };
 };
 
+// Zoom at which the whole world fits the window
+float FitZoom();
+// Centres the camera on the world, zoomed out to show all of it (at most 1:1)
+void ResetCamera(UIState& ui);
+
 class UISystem {
 public:
     void Draw(UIState& ui, World& world);
@@ -32,4 +48,5 @@ private:
     void DrawPhenotypePanel(UIState& ui, World& world);
     void DrawAnalyticsPanel(UIState& ui, World& world);
     void DrawSpeciesLegendPanel(UIState& ui, World& world);
+    void DrawProfilerPanel(UIState& ui, World& world);
 };
@@ -1,7 +1,16 @@
 #pragma once
+#include <memory>
+#include <span>
 #include <vector>
-#include <vector>
+#include "AgentStore.hpp"
+#include "BrainBatch.hpp"
 #include "Entities.hpp"
+#include "EntityPool.hpp"
+#include "InnovationRegistry.hpp"
+#include "Profiler.hpp"
+#include "Speciation.hpp"
+#include "SpatialGrid.hpp"
+#include "ObstacleField.hpp"
 
 enum class Season { Spring, Summer, Autumn, Winter };
 
@@ -20,36 +29,6 @@ struct SeasonState {
     }
 };
 
-struct SpatialGrid {
-    // Flattened grid: cells[x * GRID_H + y]
-    // Vector of Vectors for ID lists
-    std::vector<std::vector<int>> fruitIndices;
-    std::vector<std::vector<int>> poisonIndices;
-    std::vector<std::vector<int>> agentIndices;
-    std::vector<std::vector<int>> obstacleIndices;
-
-    void Resize(int w, int h) {
-        int size = w * h;
-        fruitIndices.assign(size, {});
-        poisonIndices.assign(size, {});
-        agentIndices.assign(size, {});
-        obstacleIndices.assign(size, {});
-    }
-
-    void Clear();
-    void AddFruit(int index, Vector2 pos);
-    void AddPoison(int index, Vector2 pos);
-    void AddAgent(int index, Vector2 pos);
-    void AddObstacle(int index, Vector2 pos, Vector2 size);
-    
-    // Helper to get cell index safely
-    int GetCellIndex(int x, int y) const {
-        if (x < 0) x = 0; if (x >= Config::GRID_W) x = Config::GRID_W - 1;
-        if (y < 0) y = 0; if (y >= Config::GRID_H) y = Config::GRID_H - 1;
-        return x * Config::GRID_H + y;
-    }
-};
-
 struct Stats {
     int generation = 0;
     int births = 0;
@@ -59,6 +38,7 @@ struct Stats {
     float avgFitness = 0.0f;
     float bestFitness = 0.0f;
     float totalFitness = 0.0f;
+    int neatSpecies = 0;     // Species among the last generation's NEAT survivors
     
     float avgSpeed = 0.0f;
     float avgSize = 0.0f;
@@ -77,6 +57,7 @@ struct Stats {
         int countRNN;
         int countNEAT;
         int countNN;
+        int neatSpecies;
     };
     std::vector<HistoryPoint> history;
 };
@@ -105,17 +86,33 @@ struct GeneticRecord {
 
 class World {
 public:
-    std::vector<Agent> agents;
-    std::vector<Fruit> fruits;
-    std::vector<Poison> poisons;
+    AgentStore agents;       // Column storage; agents[i] gives a field-by-field view
+    EntityPool<Fruit> fruits;    // Eaten slots are reused by respawns; indices never shift
+    EntityPool<Poison> poisons;
     std::vector<Obstacle> obstacles;
-    SpatialGrid grid;
+    SpatialGrid grid;        // Fine cells: eating, mating, hunting, collision
+    SpatialGrid visionGrid;  // Coarse cells: sensing
+    ObstacleField obstacleField;  // Baked from `obstacles` by RefreshObstacles()
     Stats stats;
     SeasonState season;
+    
+    // Every random draw in the world derives from this seed.
+    // Agents split private substreams off `rng` when they are created.
+    uint64_t seed;
+    Rng rng;
+    
+    TickProfiler profiler;
+
+    // NEAT innovation numbering; scoped to the current generation
+    std::shared_ptr<InnovationRegistry> innovations = std::make_shared<InnovationRegistry>();
 
-    World();
+    // Ticks on which the incremental grid disagreed with a full rebuild
+    // (only counted while Config::VALIDATE_GRID is set)
+    int gridValidationErrors = 0;
+
+    World(); // Seeded from std::random_device
+    explicit World(uint64_t seed);
     void Update(float dt);
-    void Draw();
     
     void GenerateRandomObstacles();
     void GenerateMaze();
@@ -124,7 +121,7 @@ public:
     void GenerateSpiral();
     void ClearObstacles();
     
-    Vector2 FindSafeSpawnPosition(float minRadius = 10.0f, int maxAttempts = 50);
+    Vec2 FindSafeSpawnPosition(float minRadius = 10.0f, int maxAttempts = 50);
     
     // God Mode Powers
     void ThanosSnap();
@@ -134,15 +131,46 @@ public:
 
     void UpdateSeasons(float dt);
 
+    // Checks the live spatial grid against a from-scratch rebuild.
+    // Only meaningful right after SyncGrid(), before agents have moved.
+    bool ValidateGrid() const;
+
 private:
+    // Kernel microbenchmarks (bench/) drive the private hot paths directly
+    friend struct WorldBenchAccess;
+
+    void SpeciateSurvivors();
+    int PickParent();
     void InitPopulation();
-    void UpdateAgent(Agent& agent, float dt, std::vector<Agent>& babies);
-    SensorData ScanSurroundings(Agent& agent);
-    void HandleInteractions(Agent& agent, std::vector<Agent>& babies);
-    bool CheckObstacleCollision(Vector2 pos, float radius);
+    int InitialPopulation() const;
+    void ConfigureGrids();
+    void FillGrid(SpatialGrid& g) const;
+    void RebuildGrid();
+    void SyncGrid();
+    void RefreshObstacles();
+    void SenseAgent(int i, float dt, std::span<float> inputs);
+    void ActAgent(int i, std::span<const float> outputs, float dt, std::vector<Agent>& babies);
+    SensorData ScanSurroundings(int i);
+    void HandleInteractions(int i, std::vector<Agent>& babies);
+    bool CheckObstacleCollision(Vec2 pos, float radius);
     
-    template <typename T>
-    void CleanupEntities(std::vector<T>& entities);
+    void CleanupAgents();
 
     std::vector<GeneticRecord> savedGenetics;
+
+    // NEAT survivors grouped by species for breeding; other brains are
+    // drawn directly. Filled by SpeciateSurvivors().
+    Speciation speciation;
+    std::vector<std::vector<int>> parentGroups;
+    std::vector<float> parentGroupFitness;   // Shared (mean) fitness per species
+    std::vector<int> survivorSpecies;   // Scratch for Speciation::Assign
+
+    // Per-tick brain I/O, one row per agent
+    BrainBatch brainBatch;
+    std::vector<float> brainInputs;
+    std::vector<float> brainOutputs;
+
+    // Incremental grid bookkeeping
+    bool gridDirty = true;        // Entity vectors were replaced wholesale
+    bool obstaclesDirty = true;   // Obstacle layers and field need rebuilding
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "Activation.hpp"
+
+namespace Activation {
+
+    // The mode is resolved once per call so each loop body is a single
+    // straight-line kernel
+    void Tanh(std::span<float> values, Config::ActivationMode mode) {
+        float* v = values.data();
+        const size_t n = values.size();
+        switch (mode) {
+            case Config::ActivationMode::Rational:
+                for (size_t i = 0; i < n; ++i) v[i] = TanhRational(v[i]);
+                break;
+            case Config::ActivationMode::Polynomial:
+                for (size_t i = 0; i < n; ++i) v[i] = TanhPolynomial(v[i]);
+                break;
+            default:
+                for (size_t i = 0; i < n; ++i) v[i] = std::tanh(v[i]);
+                break;
+        }
+    }
+
+    void Sigmoid(std::span<float> values, Config::ActivationMode mode) {
+        for (float& v : values) v *= 0.5f;
+        Tanh(values, mode);
+        for (float& v : values) v = 0.5f + 0.5f * v;
+    }
+
+    void Relu(std::span<float> values) {
+        for (float& v : values) v = std::max(v, 0.0f);
+    }
+
+    const char* ModeName(Config::ActivationMode mode) {
+        switch (mode) {
+            case Config::ActivationMode::Rational: return "rational";
+            case Config::ActivationMode::Polynomial: return "polynomial";
+            default: return "exact";
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "AgentStore.hpp"
+#include <algorithm>
+#include <utility>
+
+int AgentStore::Add(Agent&& a) {
+    int index = (int)pos.size();
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = (uint32_t)slotIndex.size();
+        slotIndex.push_back(0);
+        slotGeneration.push_back(0);
+    }
+    slotIndex[slot] = (uint32_t)index;
+    id.push_back({slot, slotGeneration[slot]});
+
+    pos.push_back(a.pos);
+    prevPos.push_back(a.prevPos);
+    angle.push_back(a.angle);
+    prevAngle.push_back(a.prevAngle);
+    energy.push_back(a.energy);
+    active.push_back(a.active ? 1 : 0);
+    phenotype.push_back(a.phenotype);
+    sex.push_back(a.sex);
+    pheromoneEmission.push_back(a.pheromoneEmission);
+    brain.push_back(std::move(a.brain));
+    brainChanged.push_back(index);
+    rng.push_back(a.rng);
+    life.push_back(a.life);
+    trace.push_back(a.trace);
+    return index;
+}
+
+void AgentStore::SwapRemove(int i) {
+    uint32_t slot = id[i].slot;
+    slotGeneration[slot]++;
+    freeSlots.push_back(slot);
+
+    int last = (int)size() - 1;
+    if (i != last) slotIndex[id[last].slot] = (uint32_t)i;
+    ForEachColumn([&](auto& column) {
+        if (i != last) column[i] = std::move(column[last]);
+        column.pop_back();
+    });
+    if (i != last) brainChanged.push_back(i);
+}
+
+void AgentStore::Clear() {
+    // Retire every live handle before the columns go
+    for (AgentId handle : id) {
+        slotGeneration[handle.slot]++;
+        freeSlots.push_back(handle.slot);
+    }
+    ForEachColumn([](auto& column) { column.clear(); });
+    brainChanged.clear(); // Every row is new now; Add() lists them again
+}
+
+void AgentStore::Reserve(size_t n) {
+    ForEachColumn([n](auto& column) { column.reserve(n); });
+}
+
+int AgentStore::CountActive() const {
+    return (int)std::count(active.begin(), active.end(), 1);
+}
@@ -0,0 +1,170 @@
+#include "BrainBatch.hpp"
+#include "NeuralNetwork.hpp"
+#include "Activation.hpp"
+#include <algorithm>
+
+void BrainBatch::Run(std::span<const std::unique_ptr<IBrain>> brains, std::span<const uint8_t> active,
+                     std::span<const int> changed, std::span<const float> inputs, std::span<float> outputs) {
+    // Rows that no longer exist give their lanes back; new rows are packed
+    int tracked = (int)rowGroup.size();
+    int count = (int)brains.size();
+    for (int i = count; i < tracked; ++i) Release(i);
+    rowGroup.resize(count, -1);
+    rowLane.resize(count, -1);
+    for (int i : changed) {
+        if (i >= count || i >= tracked) continue;
+        Release(i);
+        Assign(i, brains[i].get());
+    }
+    for (int i = tracked; i < count; ++i) Assign(i, brains[i].get());
+
+    for (int i = 0; i < count; ++i) {
+        if (!active[i] || rowGroup[i] >= 0) continue;
+        brains[i]->FeedForward(inputs.subspan((size_t)i * BRAIN_INPUTS, BRAIN_INPUTS),
+                               outputs.subspan((size_t)i * BRAIN_OUTPUTS, BRAIN_OUTPUTS));
+    }
+
+    for (const Group& g : groups) RunGroup(g, active, inputs, outputs);
+}
+
+void BrainBatch::Assign(int row, IBrain* brain) {
+    auto* nn = dynamic_cast<NeuralNetwork*>(brain);
+    if (!nn || nn->inputSize != BRAIN_INPUTS || nn->outputSize != BRAIN_OUTPUTS) return;
+
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const Group& g) { return g.hidden == nn->hiddenSize; });
+    if (it == groups.end()) {
+        groups.push_back({});
+        it = groups.end() - 1;
+        it->hidden = nn->hiddenSize;
+    }
+    Group& g = *it;
+
+    int lane;
+    if (!g.freeLanes.empty()) {
+        lane = g.freeLanes.back();
+        g.freeLanes.pop_back();
+    } else {
+        // Open a new block; its other lanes wait on the free list
+        constexpr int I = BRAIN_INPUTS;
+        constexpr int O = BRAIN_OUTPUTS;
+        const int H = g.hidden;
+        int base = (int)g.laneNet.size();
+        g.laneNet.resize(base + LANES, nullptr);
+        g.laneRow.resize(base + LANES, -1);
+        g.inputW.resize(g.inputW.size() + (size_t)H * I * LANES);
+        g.inputB.resize(g.inputB.size() + (size_t)H * LANES);
+        g.outputW.resize(g.outputW.size() + (size_t)O * H * LANES);
+        g.outputB.resize(g.outputB.size() + (size_t)O * LANES);
+        for (int l = LANES - 1; l > 0; --l) g.freeLanes.push_back(base + l);
+        lane = base;
+    }
+
+    g.laneNet[lane] = nn;
+    g.laneRow[lane] = row;
+    rowGroup[row] = (int)(it - groups.begin());
+    rowLane[row] = lane;
+    Pack(g, lane);
+}
+
+void BrainBatch::Release(int row) {
+    if (rowGroup[row] < 0) return;
+    Group& g = groups[rowGroup[row]];
+    int lane = rowLane[row];
+    g.laneNet[lane] = nullptr;
+    g.laneRow[lane] = -1;
+    g.freeLanes.push_back(lane);
+    rowGroup[row] = -1;
+    rowLane[row] = -1;
+}
+
+void BrainBatch::Pack(Group& group, int lane) {
+    constexpr int I = BRAIN_INPUTS;
+    constexpr int O = BRAIN_OUTPUTS;
+    constexpr int L = LANES;
+    const int H = group.hidden;
+    const int block = lane / L;
+    const int l = lane % L;
+
+    const NeuralNetwork& nn = *group.laneNet[lane];
+    const float* w = nn.weights.data();
+    const float* b = nn.biases.data();
+    float* inputW = &group.inputW[(size_t)block * H * I * L];
+    float* outputW = &group.outputW[(size_t)block * O * H * L];
+    float* inputB = &group.inputB[(size_t)block * H * L];
+    float* outputB = &group.outputB[(size_t)block * O * L];
+    for (int k = 0; k < H * I; ++k) inputW[k * L + l] = w[k];
+    for (int k = 0; k < O * H; ++k) outputW[k * L + l] = w[H * I + k];
+    for (int h = 0; h < H; ++h) inputB[h * L + l] = b[h];
+    for (int o = 0; o < O; ++o) outputB[o * L + l] = b[H + o];
+}
+
+void BrainBatch::RunGroup(const Group& group, std::span<const uint8_t> active,
+                          std::span<const float> inputs, std::span<float> outputs) {
+    constexpr int I = BRAIN_INPUTS;
+    constexpr int O = BRAIN_OUTPUTS;
+    constexpr int L = LANES;
+    const int H = group.hidden;
+    const int blocks = (int)group.laneNet.size() / L;
+
+    x.resize((size_t)I * L);
+    hidden.resize((size_t)H * L);
+    out.resize((size_t)O * L);
+
+    for (int block = 0; block < blocks; ++block) {
+        // Gather inputs. Free or inactive lanes keep whatever the last block
+        // left; their results are never scattered.
+        bool any = false;
+        for (int l = 0; l < L; ++l) {
+            int row = group.laneRow[block * L + l];
+            if (row < 0 || !active[row]) continue;
+            any = true;
+            const float* in = &inputs[(size_t)row * I];
+            for (int j = 0; j < I; ++j) x[j * L + l] = in[j];
+        }
+        if (!any) continue;
+
+        const float* inputW = &group.inputW[(size_t)block * H * I * L];
+        const float* outputW = &group.outputW[(size_t)block * O * H * L];
+        const float* inputB = &group.inputB[(size_t)block * H * L];
+        const float* outputB = &group.outputB[(size_t)block * O * L];
+
+        // Input -> Hidden. Terms are added in the same order as
+        // NeuralNetwork::FeedForward, so every lane matches it bit for bit.
+        for (int h = 0; h < H; ++h) {
+            float acc[L];
+            for (int l = 0; l < L; ++l) acc[l] = inputB[h * L + l];
+            const float* wRow = &inputW[(size_t)h * I * L];
+            for (int j = 0; j < I; ++j) {
+                for (int l = 0; l < L; ++l) acc[l] += x[j * L + l] * wRow[j * L + l];
+            }
+            for (int l = 0; l < L; ++l) hidden[h * L + l] = acc[l];
+        }
+        Activation::Tanh(std::span<float>(hidden.data(), (size_t)H * L));
+
+        // Hidden -> Output
+        for (int o = 0; o < O; ++o) {
+            float acc[L];
+            for (int l = 0; l < L; ++l) acc[l] = outputB[o * L + l];
+            const float* wRow = &outputW[(size_t)o * H * L];
+            for (int h = 0; h < H; ++h) {
+                for (int l = 0; l < L; ++l) acc[l] += hidden[h * L + l] * wRow[h * L + l];
+            }
+            for (int l = 0; l < L; ++l) out[o * L + l] = acc[l];
+        }
+        Activation::Tanh(std::span<float>(out.data(), (size_t)O * L));
+
+        // Scatter the outputs, and the caches lifetime learning reads
+        for (int l = 0; l < L; ++l) {
+            int row = group.laneRow[block * L + l];
+            if (row < 0 || !active[row]) continue;
+            NeuralNetwork& nn = *group.laneNet[block * L + l];
+            float* dst = &outputs[(size_t)row * O];
+            for (int j = 0; j < I; ++j) nn.cachedInputs[j] = x[j * L + l];
+            for (int h = 0; h < H; ++h) nn.cachedHidden[h] = hidden[h * L + l];
+            for (int o = 0; o < O; ++o) {
+                nn.cachedOutput[o] = out[o * L + l];
+                dst[o] = out[o * L + l];
+            }
+        }
+    }
+}
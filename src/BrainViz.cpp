@@ -0,0 +1,159 @@
+#include "BrainViz.hpp"
+#include "NeuralNetwork.hpp"
+#include "RNNBrain.hpp"
+#include "NEATBrain.hpp"
+#include <cmath>
+#include <algorithm>
+
+static void DrawFeedForward(const NeuralNetwork& nn, ImVec2 pos, ImVec2 size) {
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    
+    float nodeRadius = 8.0f;
+    float layerSpacing = size.x / 3.0f;
+    
+    int inputCount = nn.inputSize;
+    float inputSpacing = size.y / (inputCount + 1);
+    std::vector<ImVec2> inputNodes;
+    for (int i = 0; i < inputCount; ++i) {
+        ImVec2 nodePos(pos.x, pos.y + inputSpacing * (i + 1));
+        inputNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 200, 255, 200));
+    }
+    
+    int hiddenCount = nn.hiddenSize;
+    float hiddenSpacing = size.y / (hiddenCount + 1);
+    std::vector<ImVec2> hiddenNodes;
+    for (int i = 0; i < hiddenCount; ++i) {
+        ImVec2 nodePos(pos.x + layerSpacing, pos.y + hiddenSpacing * (i + 1));
+        hiddenNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(255, 200, 100, 200));
+    }
+    
+    int outputCount = nn.outputSize;
+    float outputSpacing = size.y / (outputCount + 1);
+    std::vector<ImVec2> outputNodes;
+    for (int i = 0; i < outputCount; ++i) {
+        ImVec2 nodePos(pos.x + layerSpacing * 2, pos.y + outputSpacing * (i + 1));
+        outputNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 255, 150, 200));
+    }
+    
+    int wIdx = 0;
+    for (int h = 0; h < hiddenCount; ++h) {
+        for (int i = 0; i < inputCount; ++i) {
+            float w = nn.weights[wIdx++];
+            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
+            float thickness = std::abs(w) * 2.0f;
+            draw->AddLine(inputNodes[i], hiddenNodes[h], color, thickness);
+        }
+    }
+    
+    for (int o = 0; o < outputCount; ++o) {
+        for (int h = 0; h < hiddenCount; ++h) {
+            float w = nn.weights[wIdx++];
+            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
+            float thickness = std::abs(w) * 2.0f;
+            draw->AddLine(hiddenNodes[h], outputNodes[o], color, thickness);
+        }
+    }
+}
+
+static void DrawRecurrent(const RNNBrain& rnn, ImVec2 pos, ImVec2 size) {
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    
+    float nodeRadius = 8.0f;
+    float layerSpacing = size.x / 3.0f;
+    
+    int inputCount = rnn.inputSize;
+    float inputSpacing = size.y / (inputCount + 1);
+    std::vector<ImVec2> inputNodes;
+    for (int i = 0; i < inputCount; ++i) {
+        ImVec2 nodePos(pos.x, pos.y + inputSpacing * (i + 1));
+        inputNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 200, 255, 200));
+    }
+    
+    int hiddenCount = rnn.hiddenSize;
+    float hiddenSpacing = size.y / (hiddenCount + 1);
+    std::vector<ImVec2> hiddenNodes;
+    for (int i = 0; i < hiddenCount; ++i) {
+        ImVec2 nodePos(pos.x + layerSpacing, pos.y + hiddenSpacing * (i + 1));
+        hiddenNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(255, 200, 100, 200));
+        
+        // Draw recurrent loop indicator (small circle above node)
+        draw->AddCircle(ImVec2(nodePos.x, nodePos.y - 12), 6.0f, IM_COL32(255, 255, 0, 150));
+    }
+    
+    int outputCount = rnn.outputSize;
+    float outputSpacing = size.y / (outputCount + 1);
+    std::vector<ImVec2> outputNodes;
+    for (int i = 0; i < outputCount; ++i) {
+        ImVec2 nodePos(pos.x + layerSpacing * 2, pos.y + outputSpacing * (i + 1));
+        outputNodes.push_back(nodePos);
+        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 255, 150, 200));
+    }
+    
+    // Input -> Hidden
+    for (int h = 0; h < hiddenCount; ++h) {
+        for (int i = 0; i < inputCount; ++i) {
+            float w = rnn.InputWeight(h, i);
+            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
+            float thickness = std::abs(w) * 2.0f;
+            draw->AddLine(inputNodes[i], hiddenNodes[h], color, thickness);
+        }
+    }
+    
+    // Hidden -> Output
+    int wIdx = 0;
+    for (int o = 0; o < outputCount; ++o) {
+        for (int h = 0; h < hiddenCount; ++h) {
+            float w = rnn.outputWeights[wIdx++];
+            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
+            float thickness = std::abs(w) * 2.0f;
+            draw->AddLine(hiddenNodes[h], outputNodes[o], color, thickness);
+        }
+    }
+}
+
+static void DrawNEAT(const NEATBrain& brain, ImVec2 pos, ImVec2 size) {
+    auto* draw = ImGui::GetWindowDrawList();
+
+    // Map logical X/Y to Screen X/Y
+    auto GetScreenPos = [&](float nmX, float nmY) {
+        return ImVec2(pos.x + nmX * size.x, pos.y + nmY * size.y);
+    };
+
+    // Draw connections
+    for(const auto& con : brain.genome.connections) {
+        if(!con.enabled) continue;
+
+        // Find nodes
+        float x1=0, y1=0, x2=0, y2=0;
+        bool f1=false, f2=false;
+        for(const auto& n : brain.genome.nodes) {
+            if(n.id == con.inNode) { x1=n.x; y1=n.y; f1=true; }
+            if(n.id == con.outNode) { x2=n.x; y2=n.y; f2=true; }
+        }
+        if(!f1 || !f2) continue;
+
+        ImU32 col = (con.weight > 0) ? IM_COL32(100, 255, 100, 150) : IM_COL32(255, 100, 100, 150);
+        float thickness = std::min(5.0f, std::max(1.0f, std::abs(con.weight) * 2.0f));
+        draw->AddLine(GetScreenPos(x1, y1), GetScreenPos(x2, y2), col, thickness);
+    }
+
+    // Draw nodes
+    for(const auto& n : brain.genome.nodes) {
+        ImU32 col = IM_COL32(200, 200, 200, 255);
+        if(n.type == NodeType::Sensor) col = IM_COL32(100, 200, 255, 255);
+        if(n.type == NodeType::Output) col = IM_COL32(100, 255, 100, 255);
+
+        draw->AddCircleFilled(GetScreenPos(n.x, n.y), 6.0f, col);
+    }
+}
+
+void DrawBrain(const IBrain& brain, ImVec2 pos, ImVec2 size) {
+    if (auto* nn = dynamic_cast<const NeuralNetwork*>(&brain)) DrawFeedForward(*nn, pos, size);
+    else if (auto* rnn = dynamic_cast<const RNNBrain*>(&brain)) DrawRecurrent(*rnn, pos, size);
+    else if (auto* neat = dynamic_cast<const NEATBrain*>(&brain)) DrawNEAT(*neat, pos, size);
+}
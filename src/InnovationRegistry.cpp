@@ -0,0 +1,30 @@
+#include "InnovationRegistry.hpp"
+
+int InnovationRegistry::Connection(int inNode, int outNode) {
+    if (inNode < FIRST_HIDDEN_ID && outNode < FIRST_HIDDEN_ID) return inNode * FIRST_HIDDEN_ID + outNode + 1;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (connections.size() >= MAX_ENTRIES) connections.clear();
+    auto [it, inserted] = connections.try_emplace(Key(inNode, outNode), nextInnovation);
+    if (inserted) nextInnovation++;
+    return it->second;
+}
+
+int InnovationRegistry::SplitNode(int inNode, int outNode) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (splits.size() >= MAX_ENTRIES) splits.clear();
+    auto [it, inserted] = splits.try_emplace(Key(inNode, outNode), nextNodeId + 1);
+    if (inserted) nextNodeId++;
+    return it->second;
+}
+
+void InnovationRegistry::BeginGeneration() {
+    std::lock_guard<std::mutex> lock(mutex);
+    connections.clear();
+    splits.clear();
+}
+
+size_t InnovationRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return connections.size() + splits.size();
+}
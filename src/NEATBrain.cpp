@@ -0,0 +1,148 @@
+#include "NEATBrain.hpp"
+#include "Activation.hpp"
+#include <algorithm>
+
+void NEATBrain::RebuildNetwork() {
+    const auto& nodes = genome.nodes;
+    const int n = (int)nodes.size();
+
+    // Node id -> position in genome.nodes, which is sorted by id
+    auto find = [&](int id) {
+        const NodeGene* node = genome.FindNode(id);
+        return node ? (int)(node - nodes.data()) : -1;
+    };
+
+    // Enabled links between nodes that exist. Nothing may feed a sensor.
+    struct Link { int from, to; float weight; int connection; };
+    std::vector<Link> links;
+    std::vector<int> pending(n, 0);   // Unevaluated inputs per node
+    for (int c = 0; c < (int)genome.connections.size(); ++c) {
+        const auto& con = genome.connections[c];
+        if (!con.enabled) continue;
+        int from = find(con.inNode);
+        int to = find(con.outNode);
+        if (from < 0 || to < 0 || nodes[to].type == NodeType::Sensor) continue;
+        links.push_back({from, to, con.weight, c});
+        pending[to]++;
+    }
+
+    // Outgoing links per node, for the sort
+    std::vector<int> outStart(n + 1, 0);
+    for (const Link& l : links) outStart[l.from + 1]++;
+    for (int i = 0; i < n; ++i) outStart[i + 1] += outStart[i];
+    std::vector<int> outLinks(links.size());
+    {
+        std::vector<int> cursor(outStart.begin(), outStart.end() - 1);
+        for (int e = 0; e < (int)links.size(); ++e) outLinks[cursor[links[e].from]++] = e;
+    }
+
+    std::vector<int> slot(n, -1);
+    std::vector<int> order;           // Computed nodes in slot order
+    int next = 0;
+    for (int i = 0; i < n; ++i) {
+        if (nodes[i].type == NodeType::Sensor) slot[i] = next++;
+    }
+    net.sensorCount = next;
+
+    // Kahn's algorithm, a wave at a time: each wave holds the nodes whose
+    // inputs were all evaluated by earlier waves
+    std::vector<int> wave, nextWave;
+    auto release = [&](int i, std::vector<int>& into) {
+        for (int k = outStart[i]; k < outStart[i + 1]; ++k) {
+            int to = links[outLinks[k]].to;
+            if (--pending[to] == 0) into.push_back(to);
+        }
+    };
+    for (int i = 0; i < n; ++i) {
+        if (nodes[i].type != NodeType::Sensor && pending[i] == 0) wave.push_back(i);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (nodes[i].type == NodeType::Sensor) release(i, wave);
+    }
+    while (!wave.empty()) {
+        for (int i : wave) {
+            slot[i] = next++;
+            order.push_back(i);
+        }
+        nextWave.clear();
+        for (int i : wave) release(i, nextWave);
+        wave.swap(nextWave);
+    }
+    // The mutation operators only ever link lower x to higher x, so the
+    // graph is acyclic. Should a cycle appear anyway, its nodes go last in
+    // genome order and links back into them read the previous tick's value.
+    for (int i = 0; i < n; ++i) {
+        if (slot[i] >= 0) continue;
+        slot[i] = next++;
+        order.push_back(i);
+    }
+
+    // Incoming links per computed slot, in genome order
+    const int computed = next - net.sensorCount;
+    net.bias.resize(computed);
+    for (int k = 0; k < computed; ++k) net.bias[k] = nodes[order[k]].bias;
+    net.edgeStart.assign(computed + 1, 0);
+    for (const Link& l : links) net.edgeStart[slot[l.to] - net.sensorCount + 1]++;
+    for (int k = 0; k < computed; ++k) net.edgeStart[k + 1] += net.edgeStart[k];
+    net.edgeSource.resize(links.size());
+    net.edgeWeight.resize(links.size());
+    net.connectionEdge.assign(genome.connections.size(), -1);
+    {
+        std::vector<int> cursor(net.edgeStart.begin(), net.edgeStart.end() - 1);
+        for (const Link& l : links) {
+            int e = cursor[slot[l.to] - net.sensorCount]++;
+            net.edgeSource[e] = slot[l.from];
+            net.edgeWeight[e] = l.weight;
+            net.connectionEdge[l.connection] = e;
+        }
+    }
+
+    net.outputSlots.clear();
+    for (int i = 0; i < n; ++i) {
+        if (nodes[i].type == NodeType::Output) net.outputSlots.push_back(slot[i]);
+    }
+    net.values.assign(next, 0.0f);
+}
+
+void NEATBrain::PatchWeights() {
+    for (size_t c = 0; c < genome.connections.size(); ++c) {
+        int e = net.connectionEdge[c];
+        if (e >= 0) net.edgeWeight[e] = genome.connections[c].weight;
+    }
+}
+
+bool NEATBrain::SameGraph(const Genome& a, const Genome& b) {
+    if (a.nodes.size() != b.nodes.size() || a.connections.size() != b.connections.size()) return false;
+    for (size_t c = 0; c < a.connections.size(); ++c) {
+        if (a.connections[c].innovation != b.connections[c].innovation ||
+            a.connections[c].enabled != b.connections[c].enabled) return false;
+    }
+    return true;
+}
+
+void NEATBrain::FeedForward(std::span<const float> inputs, std::span<float> outputs) {
+    float* values = net.values.data();
+    const int sensors = net.sensorCount;
+    const int given = std::min(sensors, (int)inputs.size());
+    std::copy(inputs.begin(), inputs.begin() + given, values);
+    std::fill(values + given, values + sensors, 0.0f);
+
+    const int* edgeStart = net.edgeStart.data();
+    const int* source = net.edgeSource.data();
+    const float* weight = net.edgeWeight.data();
+    const int end = (int)net.values.size();
+    // Nodes depend on their predecessors, so activation is per node. Most
+    // levels of a grown genome hold one or two nodes, where a span call
+    // costs more than it saves.
+    const Config::ActivationMode mode = Config::ACTIVATION;
+    for (int s = sensors; s < end; ++s) {
+        const int k = s - sensors;
+        float sum = net.bias[k];
+        for (int e = edgeStart[k]; e < edgeStart[k + 1]; ++e) sum += values[source[e]] * weight[e];
+        values[s] = Activation::Tanh(sum, mode);
+    }
+
+    const size_t outputCount = std::min(outputs.size(), net.outputSlots.size());
+    for (size_t o = 0; o < outputCount; ++o) outputs[o] = values[net.outputSlots[o]];
+    std::fill(outputs.begin() + outputCount, outputs.end(), 0.0f);
+}
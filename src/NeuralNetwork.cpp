@@ -1,28 +1,27 @@
 #include "NeuralNetwork.hpp"
 #include "Config.hpp"
+#include "Activation.hpp"
 #include <cmath>
 #include <algorithm>
 
-#include "imgui.h"
-
-NeuralNetwork::NeuralNetwork(int inp, int hid, int out) 
+NeuralNetwork::NeuralNetwork(int inp, int hid, int out, Rng& rng) 
     : inputSize(inp), hiddenSize(hid), outputSize(out) {
     
-    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     weights.resize((inp * hid) + (hid * out));
     biases.resize(hid + out);
-    auto& rng = GetRNG();
-    for (auto& w : weights) w = dist(rng);
-    for (auto& b : biases) b = dist(rng);
+    for (auto& w : weights) w = RandomFloat(rng, -1.0f, 1.0f);
+    for (auto& b : biases) b = RandomFloat(rng, -1.0f, 1.0f);
     
     // Initialize caches
     cachedInputs.resize(inp);
     cachedHidden.resize(hid);
     cachedOutput.resize(out);
+    outputGradients.resize(out);
+    hiddenGradients.resize(hid);
 }
 
-std::vector<float> NeuralNetwork::FeedForward(const std::vector<float>& inputs) {
-    cachedInputs = inputs;
+void NeuralNetwork::FeedForward(std::span<const float> inputs, std::span<float> outputs) {
+    std::copy(inputs.begin(), inputs.begin() + inputSize, cachedInputs.begin());
     
     int wIdx = 0;
     int bIdx = 0;
@@ -33,8 +32,9 @@ std::vector<float> NeuralNetwork::FeedForward(const std::vector<float>& inputs)
         for (int j = 0; j < inputSize; ++j) {
             sum += inputs[j] * weights[wIdx++];
         }
-        cachedHidden[i] = std::tanh(sum);
+        cachedHidden[i] = sum;
     }
+    Activation::Tanh(cachedHidden);
 
     // Hidden -> Output
     for (int i = 0; i < outputSize; ++i) {
@@ -42,18 +42,15 @@ std::vector<float> NeuralNetwork::FeedForward(const std::vector<float>& inputs)
         for (int j = 0; j < hiddenSize; ++j) {
             sum += cachedHidden[j] * weights[wIdx++];
         }
-        cachedOutput[i] = std::tanh(sum);
+        cachedOutput[i] = sum;
     }
-    return cachedOutput;
+    Activation::Tanh(cachedOutput);
+    std::copy(cachedOutput.begin(), cachedOutput.end(), outputs.begin());
 }
 
-void NeuralNetwork::Mutate(float rate, float strength) {
-    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
-    std::normal_distribution<float> noise(0.0f, strength);
-    auto& rng = GetRNG();
-
-    for (auto& w : weights) if (chance(rng) < rate) w = std::clamp(w + noise(rng), -3.0f, 3.0f);
-    for (auto& b : biases)  if (chance(rng) < rate) b = std::clamp(b + noise(rng), -3.0f, 3.0f);
+void NeuralNetwork::Mutate(float rate, float strength, Rng& rng) {
+    for (auto& w : weights) if (rng.Float01() < rate) w = std::clamp(w + rng.Normal(0.0f, strength), -3.0f, 3.0f);
+    for (auto& b : biases)  if (rng.Float01() < rate) b = std::clamp(b + rng.Normal(0.0f, strength), -3.0f, 3.0f);
 }
 
 void NeuralNetwork::LearnFromReward(float reward, float learningRate) {
@@ -62,27 +59,14 @@ void NeuralNetwork::LearnFromReward(float reward, float learningRate) {
     // Simple reinforcement learning: adjust weights based on reward
     // This uses a simplified approximation of gradients
     
-    std::vector<float> targetOutput = cachedOutput;
-    
-    for (int i = 0; i < outputSize; ++i) {
-        if (reward > 0) {
-            targetOutput[i] = cachedOutput[i] + reward * 0.1f;
-        } else {
-            targetOutput[i] = cachedOutput[i] + reward * 0.05f;
-        }
-        targetOutput[i] = std::clamp(targetOutput[i], -1.0f, 1.0f);
-    }
-    
     // Backprop the target
     // We implement Backprop locally since it's specific to this implementation
-    
-    // Backprop implementation inline
-    std::vector<float> outputGradients(outputSize);
-    std::vector<float> hiddenGradients(hiddenSize);
 
     // Output gradients
     for (int i = 0; i < outputSize; ++i) {
-        float error = targetOutput[i] - cachedOutput[i];
+        float target = cachedOutput[i] + reward * (reward > 0 ? 0.1f : 0.05f);
+        target = std::clamp(target, -1.0f, 1.0f);
+        float error = target - cachedOutput[i];
         float tanhDerivative = 1.0f - cachedOutput[i] * cachedOutput[i];
         outputGradients[i] = error * tanhDerivative;
     }
@@ -127,81 +111,26 @@ std::unique_ptr<IBrain> NeuralNetwork::Clone() const {
     return std::make_unique<NeuralNetwork>(*this);
 }
 
-std::unique_ptr<IBrain> NeuralNetwork::Crossover(const IBrain& other) const {
+std::unique_ptr<IBrain> NeuralNetwork::Crossover(const IBrain& other, Rng& rng) const {
     if (auto* otherNN = dynamic_cast<const NeuralNetwork*>(&other)) {
-        return std::make_unique<NeuralNetwork>(CrossoverStatic(*this, *otherNN));
+        return std::make_unique<NeuralNetwork>(CrossoverStatic(*this, *otherNN, rng));
     }
     // Cross-Architecture Fallback
-    if (RandomFloat(0,1) < 0.5f) {
+    if (RandomFloat(rng, 0,1) < 0.5f) {
         auto child = this->Clone();
-        child->Mutate(0.5f, 0.5f); 
+        child->Mutate(0.5f, 0.5f, rng); 
         return child;
     } else {
         auto child = other.Clone();
-        child->Mutate(0.5f, 0.5f);
+        child->Mutate(0.5f, 0.5f, rng);
         return child;
     }
 }
 
-NeuralNetwork NeuralNetwork::CrossoverStatic(const NeuralNetwork& a, const NeuralNetwork& b) {
+NeuralNetwork NeuralNetwork::CrossoverStatic(const NeuralNetwork& a, const NeuralNetwork& b, Rng& rng) {
     NeuralNetwork child = a; 
-    std::uniform_int_distribution<int> coin(0, 1);
-    auto& rng = GetRNG();
     
-    for (size_t i = 0; i < child.weights.size(); ++i) child.weights[i] = coin(rng) ? a.weights[i] : b.weights[i];
-    for (size_t i = 0; i < child.biases.size(); ++i)  child.biases[i] = coin(rng) ? a.biases[i] : b.biases[i];
+    for (size_t i = 0; i < child.weights.size(); ++i) child.weights[i] = rng.Coin() ? a.weights[i] : b.weights[i];
+    for (size_t i = 0; i < child.biases.size(); ++i)  child.biases[i] = rng.Coin() ? a.biases[i] : b.biases[i];
     return child;
 }
-
-void NeuralNetwork::Draw(ImVec2 pos, ImVec2 size) {
-    ImDrawList* draw = ImGui::GetWindowDrawList();
-    
-    float nodeRadius = 8.0f;
-    float layerSpacing = size.x / 3.0f;
-    
-    int inputCount = inputSize;
-    float inputSpacing = size.y / (inputCount + 1);
-    std::vector<ImVec2> inputNodes;
-    for (int i = 0; i < inputCount; ++i) {
-        ImVec2 nodePos(pos.x, pos.y + inputSpacing * (i + 1));
-        inputNodes.push_back(nodePos);
-        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 200, 255, 200));
-    }
-    
-    int hiddenCount = hiddenSize;
-    float hiddenSpacing = size.y / (hiddenCount + 1);
-    std::vector<ImVec2> hiddenNodes;
-    for (int i = 0; i < hiddenCount; ++i) {
-        ImVec2 nodePos(pos.x + layerSpacing, pos.y + hiddenSpacing * (i + 1));
-        hiddenNodes.push_back(nodePos);
-        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(255, 200, 100, 200));
-    }
-    
-    int outputCount = outputSize;
-    float outputSpacing = size.y / (outputCount + 1);
-    std::vector<ImVec2> outputNodes;
-    for (int i = 0; i < outputCount; ++i) {
-        ImVec2 nodePos(pos.x + layerSpacing * 2, pos.y + outputSpacing * (i + 1));
-        outputNodes.push_back(nodePos);
-        draw->AddCircleFilled(nodePos, nodeRadius, IM_COL32(100, 255, 150, 200));
-    }
-    
-    int wIdx = 0;
-    for (int h = 0; h < hiddenCount; ++h) {
-        for (int i = 0; i < inputCount; ++i) {
-            float w = weights[wIdx++];
-            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
-            float thickness = std::abs(w) * 2.0f;
-            draw->AddLine(inputNodes[i], hiddenNodes[h], color, thickness);
-        }
-    }
-    
-    for (int o = 0; o < outputCount; ++o) {
-        for (int h = 0; h < hiddenCount; ++h) {
-            float w = weights[wIdx++];
-            ImU32 color = w > 0 ? IM_COL32(100, 255, 100, 100) : IM_COL32(255, 100, 100, 100);
-            float thickness = std::abs(w) * 2.0f;
-            draw->AddLine(hiddenNodes[h], outputNodes[o], color, thickness);
-        }
-    }
-}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "ObstacleField.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double EDT_INF = 1e20;
+
+// Felzenszwalb & Huttenlocher 1D squared distance transform of f into d.
+// v and z are scratch of size n and n + 1.
+void DistanceTransform1D(const double* f, double* d, int n, int* v, double* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INF;
+    z[1] = EDT_INF;
+    for (int q = 1; q < n; ++q) {
+        double s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * q - 2.0 * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * q - 2.0 * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDT_INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        double dq = q - v[k];
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+// In-place 2D squared distance transform: columns, then rows
+void DistanceTransform2D(std::vector<double>& grid, int w, int h) {
+    int n = std::max(w, h);
+    std::vector<double> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+
+    for (int x = 0; x < w; ++x) {
+        for (int y = 0; y < h; ++y) f[y] = grid[y * w + x];
+        DistanceTransform1D(f.data(), d.data(), h, v.data(), z.data());
+        for (int y = 0; y < h; ++y) grid[y * w + x] = d[y];
+    }
+    for (int y = 0; y < h; ++y) {
+        double* row = &grid[y * w];
+        std::copy(row, row + w, f.begin());
+        DistanceTransform1D(f.data(), d.data(), w, v.data(), z.data());
+        std::copy(d.begin(), d.begin() + w, row);
+    }
+}
+
+} // namespace
+
+void ObstacleField::BakeRegion(const std::vector<Obstacle>& obstacles, int x0, int y0, int w, int h, std::vector<Texel>& out) const {
+    int count = w * h;
+    float rx0 = x0 * cell, ry0 = y0 * cell;
+    float rx1 = (x0 + w - 1) * cell, ry1 = (y0 + h - 1) * cell;
+
+    // Occupancy at the nodes; each obstacle only tests nodes inside its bounds
+    std::vector<unsigned char> solid(count, 0);
+    for (const auto& obs : obstacles) {
+        if (!obs.active) continue;
+        if (obs.pos.x > rx1 || obs.pos.y > ry1 || obs.pos.x + obs.size.x < rx0 || obs.pos.y + obs.size.y < ry0) continue;
+        int xa = std::max(x0, (int)std::ceil(obs.pos.x * invCell));
+        int ya = std::max(y0, (int)std::ceil(obs.pos.y * invCell));
+        int xb = std::min(x0 + w - 1, (int)std::floor((obs.pos.x + obs.size.x) * invCell));
+        int yb = std::min(y0 + h - 1, (int)std::floor((obs.pos.y + obs.size.y) * invCell));
+        for (int y = ya; y <= yb; ++y) {
+            for (int x = xa; x <= xb; ++x) {
+                int i = (y - y0) * w + (x - x0);
+                if (!solid[i] && obs.Contains({x * cell, y * cell})) solid[i] = 1;
+            }
+        }
+    }
+
+    // Distance from every node to the nearest solid node, and to the nearest free one
+    std::vector<double> toSolid(count), toFree(count);
+    for (int i = 0; i < count; ++i) {
+        toSolid[i] = solid[i] ? 0.0 : EDT_INF;
+        toFree[i] = solid[i] ? EDT_INF : 0.0;
+    }
+    DistanceTransform2D(toSolid, w, h);
+    DistanceTransform2D(toFree, w, h);
+
+    // The surface lies between a solid node and its free neighbour, so shift
+    // by half a cell. Anything past the band saturates at it.
+    out.resize(count);
+    for (int i = 0; i < count; ++i) {
+        float d = solid[i] ? -((float)std::sqrt(toFree[i]) * cell - 0.5f * cell)
+                           : (float)std::sqrt(toSolid[i]) * cell - 0.5f * cell;
+        out[i].d = std::clamp(d, -band, band);
+    }
+
+    // Gradient by central differences (one-sided at the region border)
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int xl = std::max(0, x - 1), xr = std::min(w - 1, x + 1);
+            int yu = std::max(0, y - 1), yd = std::min(h - 1, y + 1);
+            float gx = (out[y * w + xr].d - out[y * w + xl].d) / ((xr - xl) * cell);
+            float gy = (out[yd * w + x].d - out[yu * w + x].d) / ((yd - yu) * cell);
+            float len = std::sqrt(gx * gx + gy * gy);
+            Texel& t = out[y * w + x];
+            if (len > 1e-6f) { t.gx = gx / len; t.gy = gy / len; }
+            else { t.gx = 0.0f; t.gy = 0.0f; }
+        }
+    }
+}
+
+void ObstacleField::Bake(const std::vector<Obstacle>& obstacles, int width, int height, float cellSize, float bandWidth) {
+    mapW = width;
+    mapH = height;
+    cell = cellSize;
+    invCell = 1.0f / cellSize;
+    band = bandWidth;
+    nx = (int)std::ceil(width * invCell) + 1;
+    ny = (int)std::ceil(height * invCell) + 1;
+    // Tile t holds the cells whose top-left node is in [t * TILE, (t + 1) * TILE)
+    tilesX = (nx - 2) / TILE + 1;
+    tilesY = (ny - 2) / TILE + 1;
+
+    // Every node within the band of a solid node, plus one ring for the
+    // gradient, must see that node from inside its bake region
+    int pad = (int)std::ceil(band * invCell) + 2;
+
+    // Mark the tiles within the band of an obstacle
+    tileSlot.assign(tilesX * tilesY, -1);
+    for (const auto& obs : obstacles) {
+        if (!obs.active) continue;
+        int x0 = std::max(0, ((int)std::floor(obs.pos.x * invCell) - pad) / TILE);
+        int y0 = std::max(0, ((int)std::floor(obs.pos.y * invCell) - pad) / TILE);
+        int x1 = std::min(tilesX - 1, ((int)std::ceil((obs.pos.x + obs.size.x) * invCell) + pad) / TILE);
+        int y1 = std::min(tilesY - 1, ((int)std::ceil((obs.pos.y + obs.size.y) * invCell) + pad) / TILE);
+        for (int ty = y0; ty <= y1; ++ty) {
+            for (int tx = x0; tx <= x1; ++tx) tileSlot[ty * tilesX + tx] = 0;
+        }
+    }
+    int baked = 0;
+    for (int& slot : tileSlot) slot = slot == 0 ? baked++ : -1;
+    texels.assign((size_t)baked * TILE_TEXELS, Texel{band, 0.0f, 0.0f});
+
+    // Bake block by block: one distance transform over the marked tiles'
+    // bounding box plus padding, then copy each marked tile out of it
+    std::vector<Texel> region;
+    for (int by = 0; by < tilesY; by += BLOCK_TILES) {
+        for (int bx = 0; bx < tilesX; bx += BLOCK_TILES) {
+            int tx0 = tilesX, ty0 = tilesY, tx1 = -1, ty1 = -1;
+            for (int ty = by; ty < std::min(tilesY, by + BLOCK_TILES); ++ty) {
+                for (int tx = bx; tx < std::min(tilesX, bx + BLOCK_TILES); ++tx) {
+                    if (tileSlot[ty * tilesX + tx] < 0) continue;
+                    tx0 = std::min(tx0, tx); ty0 = std::min(ty0, ty);
+                    tx1 = std::max(tx1, tx); ty1 = std::max(ty1, ty);
+                }
+            }
+            if (tx1 < 0) continue;
+
+            int x0 = std::max(0, tx0 * TILE - pad);
+            int y0 = std::max(0, ty0 * TILE - pad);
+            int x1 = std::min(nx - 1, (tx1 + 1) * TILE + pad);
+            int y1 = std::min(ny - 1, (ty1 + 1) * TILE + pad);
+            int w = x1 - x0 + 1;
+            BakeRegion(obstacles, x0, y0, w, y1 - y0 + 1, region);
+
+            for (int ty = ty0; ty <= ty1; ++ty) {
+                for (int tx = tx0; tx <= tx1; ++tx) {
+                    int slot = tileSlot[ty * tilesX + tx];
+                    if (slot < 0) continue;
+                    Texel* dst = &texels[(size_t)slot * TILE_TEXELS];
+                    int xEnd = std::min(nx - 1, (tx + 1) * TILE);
+                    int yEnd = std::min(ny - 1, (ty + 1) * TILE);
+                    for (int y = ty * TILE; y <= yEnd; ++y) {
+                        const Texel* src = &region[(y - y0) * w + (tx * TILE - x0)];
+                        std::copy(src, src + (xEnd - tx * TILE + 1), dst + (y - ty * TILE) * TILE_STRIDE);
+                    }
+                }
+            }
+        }
+    }
+}
+
+const ObstacleField::Texel* ObstacleField::Locate(Vec2 p, float& tx, float& ty) const {
+    float fx = std::clamp(p.x * invCell, 0.0f, (float)(nx - 1));
+    float fy = std::clamp(p.y * invCell, 0.0f, (float)(ny - 1));
+    int x = std::min((int)fx, nx - 2);
+    int y = std::min((int)fy, ny - 2);
+    tx = fx - x;
+    ty = fy - y;
+    int slot = tileSlot[(y / TILE) * tilesX + x / TILE];
+    if (slot < 0) return nullptr;
+    return &texels[(size_t)slot * TILE_TEXELS + (y % TILE) * TILE_STRIDE + x % TILE];
+}
+
+float ObstacleField::Distance(Vec2 p) const {
+    float tx, ty;
+    const Texel* t = Locate(p, tx, ty);
+    if (!t) return band;
+    float top = t[0].d + (t[1].d - t[0].d) * tx;
+    float bottom = t[TILE_STRIDE].d + (t[TILE_STRIDE + 1].d - t[TILE_STRIDE].d) * tx;
+    return top + (bottom - top) * ty;
+}
+
+ObstacleField::Sample ObstacleField::Lookup(Vec2 p) const {
+    float tx, ty;
+    const Texel* t = Locate(p, tx, ty);
+    if (!t) return {band, {0.0f, 0.0f}};
+    const Texel& a = t[0];
+    const Texel& b = t[1];
+    const Texel& c = t[TILE_STRIDE];
+    const Texel& d = t[TILE_STRIDE + 1];
+    float w00 = (1 - tx) * (1 - ty), w10 = tx * (1 - ty), w01 = (1 - tx) * ty, w11 = tx * ty;
+
+    Sample s;
+    s.distance = a.d * w00 + b.d * w10 + c.d * w01 + d.d * w11;
+    float gx = a.gx * w00 + b.gx * w10 + c.gx * w01 + d.gx * w11;
+    float gy = a.gy * w00 + b.gy * w10 + c.gy * w01 + d.gy * w11;
+    float len = std::sqrt(gx * gx + gy * gy);
+    s.gradient = len > 1e-6f ? Vec2{gx / len, gy / len} : Vec2{0.0f, 0.0f};
+    return s;
+}
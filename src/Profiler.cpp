@@ -0,0 +1,29 @@
+#include "Profiler.hpp"
+
+const char* GetPhaseName(ProfPhase phase) {
+    switch (phase) {
+        case ProfPhase::Seasons: return "Seasons";
+        case ProfPhase::GridRebuild: return "GridRebuild";
+        case ProfPhase::Agents: return "Agents";
+        case ProfPhase::Sense: return "Sense";
+        case ProfPhase::Think: return "Think";
+        case ProfPhase::Interact: return "Interact";
+        case ProfPhase::Births: return "Births";
+        case ProfPhase::Cleanup: return "Cleanup";
+        case ProfPhase::Respawn: return "Respawn";
+        case ProfPhase::Generation: return "Generation";
+        default: return "Unknown";
+    }
+}
+
+void TickProfiler::WriteCsvHeader(std::FILE* f) {
+    std::fprintf(f, "tick,agents,total_ms");
+    for (int i = 0; i < PROF_PHASE_COUNT; ++i) std::fprintf(f, ",%s_ms", GetPhaseName((ProfPhase)i));
+    std::fprintf(f, "\n");
+}
+
+void TickProfiler::WriteCsvRow(std::FILE* f, long long tick, const TickProfile& p) {
+    std::fprintf(f, "%lld,%d,%.4f", tick, p.agentCount, p.totalMs);
+    for (int i = 0; i < PROF_PHASE_COUNT; ++i) std::fprintf(f, ",%.4f", p.ms[i]);
+    std::fprintf(f, "\n");
+}
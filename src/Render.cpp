@@ -0,0 +1,104 @@
+#include "Render.hpp"
+#include <algorithm>
+#include <cmath>
+
+void DrawObstacle(const Obstacle& obs) {
+    Vector2 pos = ToRaylib(obs.pos);
+    Vector2 size = ToRaylib(obs.size);
+    Color color = ToRaylib(obs.color);
+    Color outlineCol = { (unsigned char)(color.r + 40), (unsigned char)(color.g + 40), (unsigned char)(color.b + 40), 255 };
+    
+    switch (obs.type) {
+        case ObstacleType::Circle: {
+            Vector2 center = {pos.x + size.x / 2, pos.y + size.y / 2};
+            DrawCircleV(center, obs.radius, color);
+            DrawCircleLines(center.x, center.y, obs.radius, outlineCol);
+            break;
+        }
+        case ObstacleType::L_Shape: {
+            DrawRectangle(pos.x, pos.y, size.x * 0.3f, size.y, color);
+            DrawRectangleLines(pos.x, pos.y, size.x * 0.3f, size.y, outlineCol);
+            DrawRectangle(pos.x, pos.y + size.y * 0.7f, size.x, size.y * 0.3f, color);
+            DrawRectangleLines(pos.x, pos.y + size.y * 0.7f, size.x, size.y * 0.3f, outlineCol);
+            break;
+        }
+        case ObstacleType::Corridor: {
+            DrawRectangleV(pos, size, color);
+            Color gapColor = {30, 30, 35, 255};
+            float gapWidth = size.x * 0.1f;
+            DrawRectangle(pos.x + size.x * 0.35f, pos.y, gapWidth, size.y, gapColor);
+            DrawRectangle(pos.x + size.x * 0.55f, pos.y, gapWidth, size.y, gapColor);
+            DrawRectangleLinesEx({pos.x, pos.y, size.x, size.y}, 2, outlineCol);
+            break;
+        }
+        default: // Wall
+            DrawRectangleV(pos, size, color);
+            DrawRectangleLinesEx({pos.x, pos.y, size.x, size.y}, 2, outlineCol);
+            break;
+    }
+}
+
+void DrawWorld(const World& world, const Camera2D& camera, float alpha) {
+    // Visible world rectangle, padded by the largest thing drawn around a point
+    const float margin = 40.0f;
+    Vector2 viewMin = GetScreenToWorld2D({0, 0}, camera);
+    Vector2 viewMax = GetScreenToWorld2D({(float)GetScreenWidth(), (float)GetScreenHeight()}, camera);
+    auto visible = [&](Vec2 p) {
+        return p.x > viewMin.x - margin && p.x < viewMax.x + margin &&
+               p.y > viewMin.y - margin && p.y < viewMax.y + margin;
+    };
+
+    DrawRectangleLinesEx({0, 0, (float)Config::WORLD_W, (float)Config::WORLD_H}, 2.0f / camera.zoom, {60, 60, 70, 255});
+
+    for (const auto& obs : world.obstacles) {
+        if (!obs.active) continue;
+        if (obs.pos.x > viewMax.x || obs.pos.y > viewMax.y ||
+            obs.pos.x + obs.size.x < viewMin.x || obs.pos.y + obs.size.y < viewMin.y) continue;
+        DrawObstacle(obs);
+    }
+
+    for (const auto& f : world.fruits) if (f.active && visible(f.pos)) DrawCircleV(ToRaylib(f.pos), 3.0f, GREEN);
+    for (const auto& p : world.poisons) if (p.active && visible(p.pos)) DrawRectangleV(ToRaylib(Vec2Subtract(p.pos, {3,3})), {6,6}, PURPLE);
+
+    const AgentStore& agents = world.agents;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.active[i] || !visible(agents.pos[i])) continue;
+        const Phenotype& phenotype = agents.phenotype[i];
+        Vec2 cur = agents.pos[i], prev = agents.prevPos[i];
+        float emission = agents.pheromoneEmission[i];
+        
+        Color col = WHITE;
+        switch(phenotype.species) {
+            case Species::Herbivore: col = {100, 255, 100, 255}; break; // Green
+            case Species::Scavenger: col = {255, 165, 0, 255}; break;   // Orange
+            case Species::Predator:  col = {255, 50, 50, 255}; break;   // Red
+        }
+        col.a = (unsigned char)(std::max(0.2f, agents.energy[i] / Config::AGENT_MAX_ENERGY) * 255);
+        
+        float visualSize = phenotype.GetVisualSize();
+        
+        // Interpolate between ticks, except across a screen wrap
+        Vec2 lerped = cur;
+        float angle = agents.angle[i];
+        if (Vec2DistanceSqr(prev, cur) < 100.0f * 100.0f) {
+            lerped = Vec2Add(prev, Vec2Scale(Vec2Subtract(cur, prev), alpha));
+            angle = agents.prevAngle[i] + (agents.angle[i] - agents.prevAngle[i]) * alpha;
+        }
+        Vector2 pos = ToRaylib(lerped);
+        
+        // Pheromone Aura
+        if(emission > 0.1f) {
+            Color aura = {200, 100, 255, (unsigned char)(emission * 50)};
+            DrawCircleV(pos, visualSize + 10 * emission, aura);
+        }
+        
+        DrawCircleV(pos, visualSize, col);
+        
+        // Sex Indicator
+        Color sexCol = (agents.sex[i] == Sex::Male) ? BLUE : PINK;
+        DrawCircleV(pos, visualSize * 0.4f, sexCol);
+        
+        Vector2 head = { pos.x + cosf(angle)*(visualSize + 3), pos.y + sinf(angle)*(visualSize + 3) };
+        DrawLineV(pos, head, RAYWHITE);
+    }
+}
@@ -0,0 +1,214 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+void GridLayer::ResetPages(int cells) {
+    numCells = cells;
+    usedPages = 0;
+    pageSlot.assign((cells + PAGE_CELLS - 1) >> PAGE_SHIFT, -1);
+}
+
+int GridLayer::SlotOrAllocate(int cell) {
+    int& page = pageSlot[cell >> PAGE_SHIFT];
+    if (page < 0) {
+        page = usedPages++;
+        if (linked) head.resize((size_t)usedPages << PAGE_SHIFT, -1);
+    }
+    return (page << PAGE_SHIFT) | (cell & (PAGE_CELLS - 1));
+}
+
+void GridLayer::Reset(int cells) {
+    linked = false;
+    ResetPages(cells);
+    stagedCell.clear();
+    stagedIndex.clear();
+    stagedPos.clear();
+}
+
+void GridLayer::Build() {
+    int count = (int)stagedCell.size();
+
+    // Pass 0: give every touched page a block and stage slots instead of cells
+    for (int& cell : stagedCell) cell = SlotOrAllocate(cell);
+    int slots = usedPages << PAGE_SHIFT;
+
+    // Pass 1: per-slot counts, turned into inclusive end offsets
+    cellStart.assign(slots + 1, 0);
+    for (int slot : stagedCell) cellStart[slot]++;
+    int running = 0;
+    for (int c = 0; c < slots; ++c) {
+        running += cellStart[c];
+        cellStart[c] = running;
+    }
+    cellStart[slots] = count;
+
+    // Pass 2: scatter back to front so each end offset walks down to its cell's
+    // start; this keeps items of a cell in the order they were added.
+    indices.resize(count);
+    positions.resize(count);
+    for (int i = count - 1; i >= 0; --i) {
+        int slot = --cellStart[stagedCell[i]];
+        indices[slot] = stagedIndex[i];
+        positions[slot] = stagedPos[i];
+    }
+}
+
+void GridLayer::ResetLinked(int cells) {
+    linked = true;
+    ResetPages(cells);
+    head.clear();
+    next.clear();
+    prev.clear();
+    cellOf.clear();
+    entityPos.clear();
+}
+
+// Pages are allocated on first use and kept until the next reset, so memory
+// follows the area entities have visited rather than the world size
+void GridLayer::Link(int index, int cell) {
+    int slot = SlotOrAllocate(cell);
+    int first = head[slot];
+    next[index] = first;
+    prev[index] = -1;
+    if (first >= 0) prev[first] = index;
+    head[slot] = index;
+    cellOf[index] = cell;
+}
+
+void GridLayer::Unlink(int index) {
+    int cell = cellOf[index];
+    if (prev[index] >= 0) next[prev[index]] = next[index];
+    else head[Slot(cell)] = next[index];
+    if (next[index] >= 0) prev[next[index]] = prev[index];
+    cellOf[index] = -1;
+}
+
+void GridLayer::Append(int cell, Vec2 pos) {
+    next.push_back(-1);
+    prev.push_back(-1);
+    cellOf.push_back(-1);
+    entityPos.push_back(pos);
+    if (cell >= 0) Link(Tracked() - 1, cell);
+}
+
+void GridLayer::Move(int index, int cell, Vec2 pos) {
+    entityPos[index] = pos;
+    if (cellOf[index] == cell) return;
+    if (cellOf[index] >= 0) Unlink(index);
+    if (cell >= 0) Link(index, cell);
+}
+
+void GridLayer::SwapRemove(int index) {
+    if (cellOf[index] >= 0) Unlink(index);
+    int last = Tracked() - 1;
+    if (index != last) {
+        // Take over the last entity's list position rather than relinking
+        // it, so the cell keeps its order
+        int cell = cellOf[last];
+        next[index] = next[last];
+        prev[index] = prev[last];
+        cellOf[index] = cell;
+        entityPos[index] = entityPos[last];
+        if (cell >= 0) {
+            if (prev[index] >= 0) next[prev[index]] = index;
+            else head[Slot(cell)] = index;
+            if (next[index] >= 0) prev[next[index]] = index;
+        }
+    }
+    next.pop_back();
+    prev.pop_back();
+    cellOf.pop_back();
+    entityPos.pop_back();
+}
+
+bool SpatialGrid::Configure(int cell, int width, int height) {
+    if (cell == cellSize && (float)width == mapW && (float)height == mapH) return false;
+    cellSize = cell;
+    mapW = (float)width;
+    mapH = (float)height;
+    gridW = std::max(1, width / cell);
+    gridH = std::max(1, height / cell);
+    cellW = mapW / gridW;
+    cellH = mapH / gridH;
+    invCellW = 1.0f / cellW;
+    invCellH = 1.0f / cellH;
+    blocksW = (gridW + BLOCK_MASK) >> BLOCK_SHIFT;
+    blocksH = (gridH + BLOCK_MASK) >> BLOCK_SHIFT;
+    BuildWrapAxis(wrapX, gridW, mapW, true);
+    BuildWrapAxis(wrapY, gridH, mapH, false);
+    return true;
+}
+
+void SpatialGrid::BuildWrapAxis(WrapAxis& axis, int n, float period, bool isColumn) const {
+    // A ring search can reach half the larger side past either edge before it
+    // has covered the whole torus
+    int margin = std::max(gridW, gridH);
+    axis.margin = margin;
+    int count = n + 2 * margin;
+    axis.cellPart.resize(count);
+    axis.offset.resize(count);
+    for (int k = 0; k < count; ++k) {
+        int v = k - margin;
+        int wraps = v >= 0 ? v / n : -((-v + n - 1) / n);
+        int i = v - wraps * n;
+        // GetCellIndex splits into independent column and row terms
+        axis.cellPart[k] = isColumn
+            ? (((i >> BLOCK_SHIFT) * blocksH) << GridLayer::PAGE_SHIFT) | ((i & BLOCK_MASK) << BLOCK_SHIFT)
+            : ((i >> BLOCK_SHIFT) << GridLayer::PAGE_SHIFT) | (i & BLOCK_MASK);
+        axis.offset[k] = wraps * period;
+    }
+}
+
+int SpatialGrid::CellOf(Vec2 pos) const {
+    if (pos.x < 0.0f || pos.y < 0.0f || pos.x > mapW || pos.y > mapH) return -1;
+    return GetCellIndex(Column(pos.x), Row(pos.y));
+}
+
+void SpatialGrid::Clear() {
+    int numCells = NumCells();
+    fruits.Reset(numCells);
+    poisons.Reset(numCells);
+    agents.Reset(numCells);
+    obstacles.Reset(numCells);
+    obstacleCenters.Reset(numCells);
+}
+
+void SpatialGrid::AddFruit(int index, Vec2 pos) {
+    int cell = CellOf(pos);
+    if (cell >= 0) fruits.Add(cell, index, pos);
+}
+
+void SpatialGrid::AddPoison(int index, Vec2 pos) {
+    int cell = CellOf(pos);
+    if (cell >= 0) poisons.Add(cell, index, pos);
+}
+
+void SpatialGrid::AddAgent(int index, Vec2 pos) {
+    int cell = CellOf(pos);
+    if (cell >= 0) agents.Add(cell, index, pos);
+}
+
+void SpatialGrid::AddObstacle(int index, Vec2 pos, Vec2 size) {
+    int gxStart = (int)std::floor(pos.x * invCellW);
+    int gyStart = (int)std::floor(pos.y * invCellH);
+    int gxEnd = (int)std::floor((pos.x + size.x) * invCellW);
+    int gyEnd = (int)std::floor((pos.y + size.y) * invCellH);
+
+    for (int x = std::max(0, gxStart); x <= std::min(gridW - 1, gxEnd); ++x) {
+        for (int y = std::max(0, gyStart); y <= std::min(gridH - 1, gyEnd); ++y) {
+            obstacles.Add(GetCellIndex(x, y), index, pos);
+        }
+    }
+
+    Vec2 center = {pos.x + size.x / 2, pos.y + size.y / 2};
+    int cell = CellOf(center);
+    if (cell >= 0) obstacleCenters.Add(cell, index, center);
+}
+
+void SpatialGrid::Build() {
+    fruits.Build();
+    poisons.Build();
+    agents.Build();
+    obstacles.Build();
+    obstacleCenters.Build();
+}
@@ -0,0 +1,84 @@
+#include "Speciation.hpp"
+#include <algorithm>
+#include <cmath>
+
+float CompatibilityDistance(const Genome& a, const Genome& b) {
+    const auto& ga = a.connections;
+    const auto& gb = b.connections;
+    if (ga.empty() && gb.empty()) return 0.0f;
+
+    size_t i = 0, j = 0;
+    int matching = 0, disjoint = 0;
+    float weightDiff = 0.0f;
+    while (i < ga.size() && j < gb.size()) {
+        if (ga[i].innovation == gb[j].innovation) {
+            weightDiff += std::fabs(ga[i].weight - gb[j].weight);
+            matching++;
+            i++; j++;
+        } else if (ga[i].innovation < gb[j].innovation) {
+            disjoint++;
+            i++;
+        } else {
+            disjoint++;
+            j++;
+        }
+    }
+    // Whatever is left over lies past the other genome's newest gene
+    int excess = (int)(ga.size() - i) + (int)(gb.size() - j);
+
+    // Always normalized: the paper skips this below 20 genes, but here every
+    // genome starts with up to 21 links, and unnormalized counts would put
+    // each fresh random genome in a species of its own
+    float n = (float)std::max(ga.size(), gb.size());
+    float meanWeightDiff = matching > 0 ? weightDiff / matching : 0.0f;
+    return Config::NEAT_EXCESS_COEFF * excess / n
+         + Config::NEAT_DISJOINT_COEFF * disjoint / n
+         + Config::NEAT_WEIGHT_COEFF * meanWeightDiff;
+}
+
+void Speciation::Assign(std::span<const Genome* const> genomes, std::span<const float> fitness, std::vector<int>& speciesOf) {
+    for (Species& s : species) {
+        s.members = 0;
+        s.totalFitness = 0.0f;
+    }
+    firstMember.assign(species.size(), -1);
+    speciesOf.resize(genomes.size());
+
+    for (int g = 0; g < (int)genomes.size(); ++g) {
+        const Genome& genome = *genomes[g];
+        int found = -1;
+        for (int s = 0; s < (int)species.size(); ++s) {
+            if (CompatibilityDistance(genome, species[s].representative) < Config::NEAT_COMPAT_THRESHOLD) {
+                found = s;
+                break;
+            }
+        }
+        if (found < 0) {
+            found = (int)species.size();
+            species.push_back({nextId++, genome});
+            firstMember.push_back(-1);
+        }
+        Species& s = species[found];
+        s.members++;
+        s.totalFitness += fitness[g];
+        if (firstMember[found] < 0) firstMember[found] = g;
+        speciesOf[g] = found;
+    }
+
+    // Drop extinct species and hand each survivor its new representative
+    remap.assign(species.size(), -1);
+    int kept = 0;
+    for (int s = 0; s < (int)species.size(); ++s) {
+        if (species[s].members == 0) continue;
+        remap[s] = kept;
+        if (kept != s) species[kept] = std::move(species[s]);
+        species[kept].representative = *genomes[firstMember[s]];
+        kept++;
+    }
+    species.resize(kept);
+    for (int& s : speciesOf) s = remap[s];
+}
+
+void Speciation::Clear() {
+    species.clear();
+}
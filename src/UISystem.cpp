@@ -4,6 +4,8 @@
 #include "implot.h"
 #include "RNNBrain.hpp"
 #include "Config.hpp"
+#include "Render.hpp"
+#include "BrainViz.hpp"
 #include <cstdio>
 #include <algorithm>
 
@@ -33,6 +35,16 @@ void ApplyDarkTheme() {
     colors[ImGuiCol_TitleBgActive]          = ImVec4(0.15f, 0.15f, 0.18f, 1.00f);
 }
 
+float FitZoom() {
+    return std::min((float)GetScreenWidth() / Config::WORLD_W, (float)GetScreenHeight() / Config::WORLD_H);
+}
+
+void ResetCamera(UIState& ui) {
+    ui.camera.offset = { GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
+    ui.camera.target = { Config::WORLD_W / 2.0f, Config::WORLD_H / 2.0f };
+    ui.camera.zoom = std::min(1.0f, FitZoom());
+}
+
 void UISystem::Draw(UIState& ui, World& world) {
     static bool themeApplied = false;
     if(!themeApplied) { ApplyDarkTheme(); themeApplied = true; }
@@ -49,6 +61,7 @@ void UISystem::Draw(UIState& ui, World& world) {
     if (ui.showNeuralViz) DrawNeuralVizPanel(ui, world);
     if (ui.showPhenotypePanel) DrawPhenotypePanel(ui, world);
     if (ui.showAnalytics) DrawAnalyticsPanel(ui, world);
+    if (ui.showProfiler) DrawProfilerPanel(ui, world);
     DrawSpeciesLegendPanel(ui, world); // Always show legend or make toggleable? Let's keep it always or in control panel.
     // Let's make it small and unobtrusive.
     
@@ -63,28 +76,43 @@ void UISystem::DrawControlPanel(UIState& ui, World& world) {
     ImGui::Separator();
     
     // Size Selection
-    const char* sizes[] = { "Small (800x600)", "Medium (1280x720)", "Large (1920x1080)", "Huge (2560x1440)" };
-    int currentSize = (int)Config::CURRENT_SIZE;
-    if (ImGui::Combo("Sim Size", &currentSize, sizes, 4)) {
-        Config::SetWindowSize((Config::SimSize)currentSize);
+    // The world size is independent of the window; the camera views part of it
+    const char* sizes[] = { "Small (800x600)", "Medium (1280x720)", "Large (1920x1080)", "Huge (2560x1440)", "Custom" };
+    if (ImGui::Combo("Sim Size", &ui.sizeSelection, sizes, 5) && ui.sizeSelection != (int)Config::SimSize::Custom) {
+        Config::SetSimSize((Config::SimSize)ui.sizeSelection);
         world = World(); // Reset world to apply new size and population
+        ResetCamera(ui);
+    }
+    // Custom only takes effect on Apply; until then the old world keeps running
+    if (ui.sizeSelection == (int)Config::SimSize::Custom) {
+        ImGui::InputInt2("World Size", ui.customWorldSize);
+        ImGui::SameLine();
+        if (ImGui::Button("Apply")) {
+            Config::SetWorldSize(ui.customWorldSize[0], ui.customWorldSize[1]);
+            ui.customWorldSize[0] = Config::WORLD_W;
+            ui.customWorldSize[1] = Config::WORLD_H;
+            world = World();
+            ResetCamera(ui);
+        }
     }
 
     if (ImGui::Button(ui.paused ? "▶ Resume" : "⏸ Pause")) ui.paused = !ui.paused;
     ImGui::SameLine();
-    if (ImGui::Button("⏭ Step")) world.Update(1.0f / 60.0f);
+    if (ImGui::Button("⏭ Step")) world.Update(Config::SIM_DT);
     ImGui::SameLine();
     if (ImGui::Button("Reset")) world = World();
     
     ImGui::SliderFloat("Speed", &ui.timeScale, 0.1f, 5.0f, "%.1fx");
+    ImGui::Checkbox("Turbo", &ui.turbo);
+    if (ui.turbo) {
+        ImGui::SameLine();
+        ImGui::SliderFloat("Budget", &ui.turboBudgetMs, 1.0f, 30.0f, "%.0f ms");
+    }
     
     ImGui::Separator();
     ImGui::Text("View Options");
     ImGui::Checkbox("Free Camera", &ui.freeCam);
-    if (ImGui::Button("Reset Camera")) {
-        ui.camera.target = { (float)Config::SCREEN_W / 2.0f, (float)Config::SCREEN_H / 2.0f };
-        ui.camera.zoom = 1.0f;
-    }
+    if (ImGui::Button("Reset Camera")) ResetCamera(ui);
     
     ImGui::Separator();
     ImGui::Text("Windows");
@@ -93,11 +121,11 @@ void UISystem::DrawControlPanel(UIState& ui, World& world) {
     ImGui::Checkbox("Neural Network", &ui.showNeuralViz);
     ImGui::Checkbox("Phenotype Evolution", &ui.showPhenotypePanel);
     ImGui::Checkbox("Analytics", &ui.showAnalytics);
+    ImGui::Checkbox("Profiler", &ui.showProfiler);
     ImGui::End();
 }
 
 void UISystem::DrawStatsPanel(UIState& ui, World& world) {
-    (void)ui;
     ImGui::Begin("Global Statistics");
     ImGui::Text("Generation: %d", world.stats.generation);
     ImGui::Text("Population: %zu", world.agents.size());
@@ -107,7 +135,9 @@ void UISystem::DrawStatsPanel(UIState& ui, World& world) {
     ImGui::Text("Best Fitness: %.2f", world.stats.bestFitness);
     ImGui::Separator();
     ImGui::Text("FPS: %d", GetFPS());
+    ImGui::Text("Ticks/s: %.0f (%d/frame)", ui.ticksPerSecond, ui.ticksLastFrame);
     ImGui::Text("Elapsed: %.1fs", world.stats.time);
+    ImGui::Text("Seed: %llu", (unsigned long long)world.seed);
     
     ImGui::Separator();
     const char* seasonName = world.season.GetName();
@@ -152,6 +182,9 @@ void UISystem::DrawConfigPanel(UIState& ui, World& world) {
     ImGui::SliderFloat("Brain Mut Rate", &Config::CHILD_BRAIN_MUTATION_RATE, 0.0f, 1.0f);
     ImGui::SliderFloat("Brain Mut Power", &Config::CHILD_BRAIN_MUTATION_POWER, 0.0f, 1.0f);
     ImGui::SliderFloat("Pheno Mut Rate", &Config::CHILD_PHENOTYPE_MUTATION_RATE, 0.0f, 1.0f);
+    const char* activations[] = { "Exact", "Rational", "Polynomial" };
+    int activation = (int)Config::ACTIVATION;
+    if (ImGui::Combo("Neuron tanh", &activation, activations, 3)) Config::ACTIVATION = (Config::ActivationMode)activation;
     
     ImGui::Separator();
     ImGui::Text("Season Control");
@@ -169,11 +202,11 @@ void UISystem::DrawGodModePanel(UIState& ui, World& world) {
     ImGui::Separator();
     ImGui::Text("Spawning");
     if (ImGui::Button("Spawn 10 Fruits")) {
-        for(int i=0; i<10; i++) world.fruits.push_back({world.FindSafeSpawnPosition(5.0f, 30)});
+        for(int i=0; i<10; i++) world.fruits.Spawn({world.FindSafeSpawnPosition(5.0f, 30)});
     }
     ImGui::SameLine();
     if (ImGui::Button("Spawn 10 Poisons")) {
-        for(int i=0; i<10; i++) world.poisons.push_back({world.FindSafeSpawnPosition(5.0f, 30)});
+        for(int i=0; i<10; i++) world.poisons.Spawn({world.FindSafeSpawnPosition(5.0f, 30)});
     }
     
     if (ImGui::Button("+5 Herbivores")) world.SpawnSpecies(Species::Herbivore, 5);
@@ -216,22 +249,24 @@ void UISystem::DrawAgentStatsPanel(UIState& ui, World& world) {
     
     ImGui::BeginChild("List", ImVec2(0, 150), true);
     for (int i = 0; i < (int)world.agents.size(); ++i) {
-        if (!world.agents[i].active) continue;
-        char label[64]; snprintf(label, 64, "Agent #%d (%s)", i, world.agents[i].sex == Sex::Male ? "M" : "F");
-        if (ImGui::Selectable(label, ui.selectedAgentIdx == i)) ui.selectedAgentIdx = i;
+        if (!world.agents.active[i]) continue;
+        AgentId id = world.agents.id[i];
+        char label[64]; snprintf(label, 64, "Agent #%u (%s)", id.slot, world.agents.sex[i] == Sex::Male ? "M" : "F");
+        if (ImGui::Selectable(label, ui.selectedAgent == id)) ui.selectedAgent = id;
     }
     ImGui::EndChild();
     
-    if (ui.selectedAgentIdx >= 0 && ui.selectedAgentIdx < (int)world.agents.size()) {
-        Agent& a = world.agents[ui.selectedAgentIdx];
-        if (a.active) {
+    if (ui.selectedAgent.Valid()) {
+        int idx = world.agents.IndexOf(ui.selectedAgent);
+        if (idx >= 0 && world.agents.active[idx]) {
+            AgentRef a = world.agents[idx];
             ImGui::Text("Energy: %.1f", a.energy);
             ImGui::Text("Fitness: %.2f", a.CalculateFitness());
             if (ImGui::Button("Follow")) {
-                ui.camera.target = a.pos;
+                ui.camera.target = ToRaylib(a.pos);
                 ui.camera.zoom = 2.0f;
             }
-            if (ImGui::Button("Kill")) a.active = false;
+            if (ImGui::Button("Kill")) a.active = 0;
         } else ImGui::Text("Agent is dead");
     }
     ImGui::End();
@@ -239,11 +274,12 @@ void UISystem::DrawAgentStatsPanel(UIState& ui, World& world) {
 
 void UISystem::DrawNeuralVizPanel(UIState& ui, World& world) {
     ImGui::Begin("Brain Visualizer", &ui.showNeuralViz);
-    if (ui.selectedAgentIdx >= 0 && ui.selectedAgentIdx < (int)world.agents.size()) {
-        Agent& a = world.agents[ui.selectedAgentIdx];
-        if (a.active) {
+    if (ui.selectedAgent.Valid()) {
+        int idx = world.agents.IndexOf(ui.selectedAgent);
+        if (idx >= 0 && world.agents.active[idx]) {
+            AgentRef a = world.agents[idx];
             ImVec2 vizSize(400, 300);
-            a.brain->Draw(ImGui::GetCursorScreenPos(), vizSize);
+            DrawBrain(*a.brain, ImGui::GetCursorScreenPos(), vizSize);
             ImGui::Dummy(vizSize);
             ImGui::Text("Type: %s", a.brain->GetType().c_str());
         } else ImGui::Text("Agent is dead");
@@ -332,20 +368,93 @@ void UISystem::DrawAnalyticsPanel(UIState& ui, World& world) {
         }
         
         if (ImPlot::BeginPlot("Brain Demographics")) {
-            std::vector<float> gens, rnn, neat, nn;
+            std::vector<float> gens, rnn, neat, nn, neatSpecies;
             for(size_t i=0; i<world.stats.history.size(); ++i) {
                 gens.push_back((float)i);
                 rnn.push_back((float)world.stats.history[i].countRNN);
                 neat.push_back((float)world.stats.history[i].countNEAT);
                 nn.push_back((float)world.stats.history[i].countNN);
+                neatSpecies.push_back((float)world.stats.history[i].neatSpecies);
             }
             
             ImPlot::PlotLine("RNN", gens.data(), rnn.data(), (int)gens.size());
             ImPlot::PlotLine("NEAT", gens.data(), neat.data(), (int)gens.size());
             ImPlot::PlotLine("FeedForward", gens.data(), nn.data(), (int)gens.size());
+            ImPlot::PlotLine("NEAT Species", gens.data(), neatSpecies.data(), (int)gens.size());
             ImPlot::EndPlot();
         }
     }
     
     ImGui::End();
 }
+
+void UISystem::DrawProfilerPanel(UIState& ui, World& world) {
+    ImGui::Begin("Tick Profiler", &ui.showProfiler);
+    
+    const TickProfiler& prof = world.profiler;
+    if (!TickProfiler::Enabled()) {
+        ImGui::Text("Profiling was compiled out (MICROCOSM_PROFILING=OFF).");
+        ImGui::End();
+        return;
+    }
+    if (prof.Size() == 0) {
+        ImGui::Text("No ticks recorded yet.");
+        ImGui::End();
+        return;
+    }
+    
+    // Exclusive layers, stacked bottom to top. "Agent Other" is movement,
+    // metabolism and stats gathering (Agents minus the nested scopes).
+    struct Layer { const char* name; ProfPhase phase; bool agentOther; };
+    const Layer layers[] = {
+        {"Grid Rebuild", ProfPhase::GridRebuild, false},
+        {"Sense", ProfPhase::Sense, false},
+        {"Think", ProfPhase::Think, false},
+        {"Interact", ProfPhase::Interact, false},
+        {"Agent Other", ProfPhase::Agents, true},
+        {"Births", ProfPhase::Births, false},
+        {"Cleanup", ProfPhase::Cleanup, false},
+        {"Respawn", ProfPhase::Respawn, false},
+        {"Generation", ProfPhase::Generation, false},
+        {"Seasons", ProfPhase::Seasons, false},
+    };
+    const int layerCount = (int)(sizeof(layers) / sizeof(layers[0]));
+    auto LayerMs = [](const TickProfile& p, const Layer& l) {
+        return l.agentOther ? p.AgentOtherMs() : p.ms[(int)l.phase];
+    };
+    
+    int n = prof.Size();
+    std::vector<float> xs(n);
+    std::vector<float> lower(n, 0.0f), upper(n, 0.0f);
+    float avg[layerCount] = {};
+    float avgTotal = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        xs[i] = (float)i;
+        avgTotal += prof.At(i).totalMs;
+        for (int l = 0; l < layerCount; ++l) avg[l] += LayerMs(prof.At(i), layers[l]);
+    }
+    
+    const TickProfile* last = prof.Last();
+    ImGui::Text("Last tick: %.3f ms | %d agents | avg %.3f ms over %d ticks",
+                last->totalMs, last->agentCount, avgTotal / n, n);
+    
+    if (ImPlot::BeginPlot("Phase Timeline (ms)")) {
+        ImPlot::SetupAxes("Tick", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        for (int l = 0; l < layerCount; ++l) {
+            for (int i = 0; i < n; ++i) {
+                lower[i] = upper[i];
+                upper[i] += LayerMs(prof.At(i), layers[l]);
+            }
+            ImPlot::PlotShaded(layers[l].name, xs.data(), lower.data(), upper.data(), n);
+        }
+        ImPlot::EndPlot();
+    }
+    
+    ImGui::Separator();
+    for (int l = 0; l < layerCount; ++l) {
+        float ms = avg[l] / n;
+        ImGui::Text("%-14s %8.3f ms  (%4.1f%%)", layers[l].name, ms, avgTotal > 0.0f ? 100.0f * ms * n / avgTotal : 0.0f);
+    }
+    
+    ImGui::End();
+}
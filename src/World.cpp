@@ -1,65 +1,40 @@
 #include "World.hpp"
+#include "NEATBrain.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
 
-// --- Spatial Grid Implementation ---
-void SpatialGrid::Clear() {
-    int expectedSize = Config::GRID_W * Config::GRID_H;
-    if (fruitIndices.size() != (size_t)expectedSize) Resize(Config::GRID_W, Config::GRID_H);
-    
-    for(auto& list : fruitIndices) list.clear();
-    for(auto& list : poisonIndices) list.clear();
-    for(auto& list : agentIndices) list.clear();
-    for(auto& list : obstacleIndices) list.clear();
-}
+// --- World Implementation ---
 
-void SpatialGrid::AddFruit(int index, Vector2 pos) {
-    int gx = (int)pos.x / Config::GRID_CELL_SIZE;
-    int gy = (int)pos.y / Config::GRID_CELL_SIZE;
-    if (gx >= 0 && gx < Config::GRID_W && gy >= 0 && gy < Config::GRID_H)
-        fruitIndices[GetCellIndex(gx, gy)].push_back(index);
-}
+namespace {
+// Grid cells are synced once per tick but agents keep moving (a few pixels per
+// tick at most), so queries against agent layers widen their radius by this much
+constexpr float GRID_SLACK = 8.0f;
 
-void SpatialGrid::AddPoison(int index, Vector2 pos) {
-    int gx = (int)pos.x / Config::GRID_CELL_SIZE;
-    int gy = (int)pos.y / Config::GRID_CELL_SIZE;
-    if (gx >= 0 && gx < Config::GRID_W && gy >= 0 && gy < Config::GRID_H)
-        poisonIndices[GetCellIndex(gx, gy)].push_back(index);
+// Brings a point that strayed at most one map width past an edge back in
+Vec2 WrapToWorld(Vec2 p) {
+    if (p.x < 0.0f) p.x += Config::WORLD_W; else if (p.x > Config::WORLD_W) p.x -= Config::WORLD_W;
+    if (p.y < 0.0f) p.y += Config::WORLD_H; else if (p.y > Config::WORLD_H) p.y -= Config::WORLD_H;
+    return p;
 }
-
-void SpatialGrid::AddAgent(int index, Vector2 pos) {
-    int gx = (int)pos.x / Config::GRID_CELL_SIZE;
-    int gy = (int)pos.y / Config::GRID_CELL_SIZE;
-    if (gx >= 0 && gx < Config::GRID_W && gy >= 0 && gy < Config::GRID_H)
-        agentIndices[GetCellIndex(gx, gy)].push_back(index);
 }
 
-void SpatialGrid::AddObstacle(int index, Vector2 pos, Vector2 size) {
-    int gxStart = (int)pos.x / Config::GRID_CELL_SIZE;
-    int gyStart = (int)pos.y / Config::GRID_CELL_SIZE;
-    int gxEnd = (int)(pos.x + size.x) / Config::GRID_CELL_SIZE;
-    int gyEnd = (int)(pos.y + size.y) / Config::GRID_CELL_SIZE;
-    
-    for (int x = std::max(0, gxStart); x <= std::min(Config::GRID_W - 1, gxEnd); ++x) {
-        for (int y = std::max(0, gyStart); y <= std::min(Config::GRID_H - 1, gyEnd); ++y) {
-            obstacleIndices[GetCellIndex(x, y)].push_back(index);
-        }
-    }
-}
+World::World() : World(std::random_device{}()) {}
 
-// --- World Implementation ---
-
-World::World() {
+World::World(uint64_t seed) : seed(seed), rng(seed) {
     if (Config::OBSTACLES_ENABLED) {
         GenerateRandomObstacles();
     }
     InitPopulation();
 }
 
-Vector2 World::FindSafeSpawnPosition(float minRadius, int maxAttempts) {
+Vec2 World::FindSafeSpawnPosition(float minRadius, int maxAttempts) {
+    RefreshObstacles(); // May run between ticks, after a config or map change
     for (int attempt = 0; attempt < maxAttempts; ++attempt) {
-        Vector2 pos = {
-            RandomFloat(minRadius + 50, Config::SCREEN_W - minRadius - 50), 
-            RandomFloat(minRadius + 50, Config::SCREEN_H - minRadius - 50)
+        Vec2 pos = {
+            RandomFloat(rng, minRadius + 50, Config::WORLD_W - minRadius - 50), 
+            RandomFloat(rng, minRadius + 50, Config::WORLD_H - minRadius - 50)
         };
         
         // Check if position collides with any obstacle
@@ -70,9 +45,9 @@ Vector2 World::FindSafeSpawnPosition(float minRadius, int maxAttempts) {
     
     // Fallback: try center area
     for (int attempt = 0; attempt < 20; ++attempt) {
-        Vector2 pos = {
-            Config::SCREEN_W / 2.0f + RandomFloat(-100, 100),
-            Config::SCREEN_H / 2.0f + RandomFloat(-100, 100)
+        Vec2 pos = {
+            Config::WORLD_W / 2.0f + RandomFloat(rng, -100, 100),
+            Config::WORLD_H / 2.0f + RandomFloat(rng, -100, 100)
         };
         if (!CheckObstacleCollision(pos, minRadius)) {
             return pos;
@@ -80,30 +55,33 @@ Vector2 World::FindSafeSpawnPosition(float minRadius, int maxAttempts) {
     }
     
     // Last resort: return center
-    return {Config::SCREEN_W / 2.0f, Config::SCREEN_H / 2.0f};
+    return {Config::WORLD_W / 2.0f, Config::WORLD_H / 2.0f};
 }
 
 void World::GenerateRandomObstacles() {
     obstacles.clear();
+    obstaclesDirty = true;
     
     for (int i = 0; i < Config::OBSTACLE_COUNT; ++i) {
-        Vector2 pos = {RandomFloat(100, Config::SCREEN_W - 300), 
-                      RandomFloat(100, Config::SCREEN_H - 300)};
-        Vector2 size = {RandomFloat(60, 120), RandomFloat(60, 120)};
+        Vec2 pos = {RandomFloat(rng, 100, Config::WORLD_W - 300), 
+                      RandomFloat(rng, 100, Config::WORLD_H - 300)};
+        Vec2 size = {RandomFloat(rng, 60, 120), RandomFloat(rng, 60, 120)};
         
         // Random obstacle type
-        ObstacleType type = (ObstacleType)(int)RandomFloat(0, 4);
+        ObstacleType type = (ObstacleType)(int)RandomFloat(rng, 0, 4);
         obstacles.push_back(Obstacle(pos, size, type));
     }
+    RefreshObstacles();
 }
 
 void World::GenerateMaze() {
     obstacles.clear();
+    obstaclesDirty = true;
     
     int wallThickness = 15;
     int gridSize = 4;
-    float cellWidth = (Config::SCREEN_W - 200) / gridSize;
-    float cellHeight = (Config::SCREEN_H - 200) / gridSize;
+    float cellWidth = (Config::WORLD_W - 200) / gridSize;
+    float cellHeight = (Config::WORLD_H - 200) / gridSize;
     
     // Create grid walls with strategic gaps
     for (int i = 0; i <= gridSize; ++i) {
@@ -111,7 +89,7 @@ void World::GenerateMaze() {
         if (i < gridSize) {
             float y = 100 + i * cellHeight;
             for (int j = 0; j < gridSize; ++j) {
-                if (RandomFloat(0, 100) < 60) { // 60% chance of wall segment
+                if (RandomFloat(rng, 0, 100) < 60) { // 60% chance of wall segment
                     float x = 100 + j * cellWidth;
                     obstacles.push_back(Obstacle(
                         {x, y}, 
@@ -126,7 +104,7 @@ void World::GenerateMaze() {
         if (i < gridSize) {
             float x = 100 + i * cellWidth;
             for (int j = 0; j < gridSize; ++j) {
-                if (RandomFloat(0, 100) < 60) { // 60% chance of wall segment
+                if (RandomFloat(rng, 0, 100) < 60) { // 60% chance of wall segment
                     float y = 100 + j * cellHeight;
                     obstacles.push_back(Obstacle(
                         {x, y}, 
@@ -141,70 +119,74 @@ void World::GenerateMaze() {
     // Add some circular obstacles at intersections
     for (int i = 1; i < gridSize; ++i) {
         for (int j = 1; j < gridSize; ++j) {
-            if (RandomFloat(0, 100) < 30) {
+            if (RandomFloat(rng, 0, 100) < 30) {
                 float x = 100 + i * cellWidth - 20;
                 float y = 100 + j * cellHeight - 20;
                 obstacles.push_back(Obstacle({x, y}, {40, 40}, ObstacleType::Circle));
             }
         }
     }
+    RefreshObstacles();
 }
 
 void World::GenerateArena() {
     obstacles.clear();
+    obstaclesDirty = true;
     
     int wallThickness = 20;
     
     // Outer border walls
-    obstacles.push_back(Obstacle({50, 50}, {Config::SCREEN_W - 100, wallThickness}, ObstacleType::Wall));
-    obstacles.push_back(Obstacle({50, Config::SCREEN_H - 70}, {Config::SCREEN_W - 100, wallThickness}, ObstacleType::Wall));
-    obstacles.push_back(Obstacle({50, 50}, {wallThickness, Config::SCREEN_H - 100}, ObstacleType::Wall));
-    obstacles.push_back(Obstacle({Config::SCREEN_W - 70, 50}, {wallThickness, Config::SCREEN_H - 100}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({50, 50}, {Config::WORLD_W - 100, wallThickness}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({50, Config::WORLD_H - 70}, {Config::WORLD_W - 100, wallThickness}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({50, 50}, {wallThickness, Config::WORLD_H - 100}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({Config::WORLD_W - 70, 50}, {wallThickness, Config::WORLD_H - 100}, ObstacleType::Wall));
     
     // Central structure - mix of shapes
-    float centerX = Config::SCREEN_W / 2.0f;
-    float centerY = Config::SCREEN_H / 2.0f;
+    float centerX = Config::WORLD_W / 2.0f;
+    float centerY = Config::WORLD_H / 2.0f;
     
     // Large central circle
     obstacles.push_back(Obstacle({centerX - 60, centerY - 60}, {120, 120}, ObstacleType::Circle));
     
     // Four L-shapes in corners creating chambers
     obstacles.push_back(Obstacle({150, 150}, {100, 100}, ObstacleType::L_Shape));
-    obstacles.push_back(Obstacle({Config::SCREEN_W - 250, 150}, {100, 100}, ObstacleType::L_Shape));
-    obstacles.push_back(Obstacle({150, Config::SCREEN_H - 250}, {100, 100}, ObstacleType::L_Shape));
-    obstacles.push_back(Obstacle({Config::SCREEN_W - 250, Config::SCREEN_H - 250}, {100, 100}, ObstacleType::L_Shape));
+    obstacles.push_back(Obstacle({Config::WORLD_W - 250, 150}, {100, 100}, ObstacleType::L_Shape));
+    obstacles.push_back(Obstacle({150, Config::WORLD_H - 250}, {100, 100}, ObstacleType::L_Shape));
+    obstacles.push_back(Obstacle({Config::WORLD_W - 250, Config::WORLD_H - 250}, {100, 100}, ObstacleType::L_Shape));
     
     // Corridors connecting areas
     obstacles.push_back(Obstacle({centerX - 150, centerY - 10}, {120, 20}, ObstacleType::Corridor));
     obstacles.push_back(Obstacle({centerX + 30, centerY - 10}, {120, 20}, ObstacleType::Corridor));
     obstacles.push_back(Obstacle({centerX - 10, centerY - 150}, {20, 120}, ObstacleType::Corridor));
     obstacles.push_back(Obstacle({centerX - 10, centerY + 30}, {20, 120}, ObstacleType::Corridor));
+    RefreshObstacles();
 }
 
 void World::GenerateRooms() {
     obstacles.clear();
+    obstaclesDirty = true;
     
     int wallThickness = 15;
     
     // Create a layout with distinct rooms
-    float midX = Config::SCREEN_W / 2.0f;
-    float midY = Config::SCREEN_H / 2.0f;
+    float midX = Config::WORLD_W / 2.0f;
+    float midY = Config::WORLD_H / 2.0f;
     
     // Horizontal divider with gaps (doorways)
     obstacles.push_back(Obstacle({100, midY - wallThickness/2}, {midX - 150, wallThickness}, ObstacleType::Wall));
-    obstacles.push_back(Obstacle({midX + 50, midY - wallThickness/2}, {Config::SCREEN_W - midX - 150, wallThickness}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({midX + 50, midY - wallThickness/2}, {Config::WORLD_W - midX - 150, wallThickness}, ObstacleType::Wall));
     
     // Vertical divider with gaps
     obstacles.push_back(Obstacle({midX - wallThickness/2, 100}, {wallThickness, midY - 150}, ObstacleType::Wall));
-    obstacles.push_back(Obstacle({midX - wallThickness/2, midY + 50}, {wallThickness, Config::SCREEN_H - midY - 150}, ObstacleType::Wall));
+    obstacles.push_back(Obstacle({midX - wallThickness/2, midY + 50}, {wallThickness, Config::WORLD_H - midY - 150}, ObstacleType::Wall));
     
     // Add furniture/obstacles in each room
     int roomCount = 4;
     float roomPositions[4][2] = {
-        {Config::SCREEN_W * 0.25f, Config::SCREEN_H * 0.25f},
-        {Config::SCREEN_W * 0.75f, Config::SCREEN_H * 0.25f},
-        {Config::SCREEN_W * 0.25f, Config::SCREEN_H * 0.75f},
-        {Config::SCREEN_W * 0.75f, Config::SCREEN_H * 0.75f}
+        {Config::WORLD_W * 0.25f, Config::WORLD_H * 0.25f},
+        {Config::WORLD_W * 0.75f, Config::WORLD_H * 0.25f},
+        {Config::WORLD_W * 0.25f, Config::WORLD_H * 0.75f},
+        {Config::WORLD_W * 0.75f, Config::WORLD_H * 0.75f}
     };
     
     for (int i = 0; i < roomCount; ++i) {
@@ -212,25 +194,27 @@ void World::GenerateRooms() {
         float y = roomPositions[i][1];
         
         // Add 1-3 obstacles per room
-        int obstacleCount = 1 + (int)RandomFloat(0, 3);
+        int obstacleCount = 1 + (int)RandomFloat(rng, 0, 3);
         for (int j = 0; j < obstacleCount; ++j) {
-            float offsetX = RandomFloat(-80, 80);
-            float offsetY = RandomFloat(-80, 80);
-            Vector2 obsPos = {x + offsetX, y + offsetY};
-            Vector2 obsSize = {RandomFloat(30, 70), RandomFloat(30, 70)};
+            float offsetX = RandomFloat(rng, -80, 80);
+            float offsetY = RandomFloat(rng, -80, 80);
+            Vec2 obsPos = {x + offsetX, y + offsetY};
+            Vec2 obsSize = {RandomFloat(rng, 30, 70), RandomFloat(rng, 30, 70)};
             
-            ObstacleType type = (RandomFloat(0, 2) < 1) ? ObstacleType::Circle : ObstacleType::Wall;
+            ObstacleType type = (RandomFloat(rng, 0, 2) < 1) ? ObstacleType::Circle : ObstacleType::Wall;
             obstacles.push_back(Obstacle(obsPos, obsSize, type));
         }
     }
+    RefreshObstacles();
 }
 
 void World::GenerateSpiral() {
     obstacles.clear();
+    obstaclesDirty = true;
     
     int wallThickness = 15;
-    float centerX = Config::SCREEN_W / 2.0f;
-    float centerY = Config::SCREEN_H / 2.0f;
+    float centerX = Config::WORLD_W / 2.0f;
+    float centerY = Config::WORLD_H / 2.0f;
     
     // Create a spiral pattern
     int segments = 20;
@@ -238,13 +222,13 @@ void World::GenerateSpiral() {
     float radiusStep = 15.0f;
     
     for (int i = 0; i < segments; ++i) {
-        float angle = (i * angleStep) * DEG2RAD;
+        float angle = (i * angleStep) * Math::Deg2Rad;
         float radius = 50 + i * radiusStep;
         
         float x = centerX + cos(angle) * radius;
         float y = centerY + sin(angle) * radius;
         
-        float nextAngle = ((i + 1) * angleStep) * DEG2RAD;
+        float nextAngle = ((i + 1) * angleStep) * Math::Deg2Rad;
         float nextRadius = 50 + (i + 1) * radiusStep;
         float nextX = centerX + cos(nextAngle) * nextRadius;
         float nextY = centerY + sin(nextAngle) * nextRadius;
@@ -259,48 +243,105 @@ void World::GenerateSpiral() {
     
     // Add some circular obstacles for variety
     for (int i = 0; i < 8; ++i) {
-        float angle = (i * 45) * DEG2RAD;
-        float radius = 150 + RandomFloat(-30, 30);
+        float angle = (i * 45) * Math::Deg2Rad;
+        float radius = 150 + RandomFloat(rng, -30, 30);
         float x = centerX + cos(angle) * radius - 20;
         float y = centerY + sin(angle) * radius - 20;
         obstacles.push_back(Obstacle({x, y}, {40, 40}, ObstacleType::Circle));
     }
+    RefreshObstacles();
 }
 
 void World::ClearObstacles() {
     obstacles.clear();
+    obstaclesDirty = true;
+    RefreshObstacles();
+}
+
+// Assumes the grids' obstacle layers and the field are current: Update
+// refreshes them in SyncGrid, generators and spawn paths refresh on entry
+bool World::CheckObstacleCollision(Vec2 pos, float radius) {
+    if (Config::OBSTACLE_SDF) return obstacleField.Distance(pos) < radius;
+
+    // Exact path: broadphase through the contact grid's obstacle layer, then
+    // only walls rasterized into the cells the circle overlaps are tested analytically
+    bool clear = grid.ForEachInRadius(grid.obstacles, pos, radius, [&](int idx, Vec2) {
+        return !obstacles[idx].Intersects(pos, radius);
+    });
+    return !clear;
+}
+
+int World::InitialPopulation() const {
+    if (Config::INITIAL_POPULATION > 0) return Config::INITIAL_POPULATION;
+    return Config::SizedCount(60, 120, 200, 350);
 }
 
-bool World::CheckObstacleCollision(Vector2 pos, float radius) {
-    // Check all obstacles using proper collision detection
-    for (const auto& obs : obstacles) {
-        if (obs.active && obs.Intersects(pos, radius)) {
-            return true;
+void World::SpeciateSurvivors() {
+    std::sort(savedGenetics.begin(), savedGenetics.end(), 
+              [](const GeneticRecord& a, const GeneticRecord& b) {
+                  return a.fitness > b.fitness;
+              });
+    
+    if (savedGenetics.size() > 30) {
+        savedGenetics.erase(savedGenetics.begin() + 30, savedGenetics.end());
+    }
+
+    // NEAT survivors, fittest first as Speciation::Assign expects
+    std::vector<const Genome*> genomes;
+    std::vector<float> fitness;
+    std::vector<int> records;
+    for (int i = 0; i < (int)savedGenetics.size(); ++i) {
+        if (auto* neat = dynamic_cast<const NEATBrain*>(savedGenetics[i].brain.get())) {
+            genomes.push_back(&neat->genome);
+            fitness.push_back(savedGenetics[i].fitness);
+            records.push_back(i);
         }
     }
-    return false;
+
+    speciation.Assign(genomes, fitness, survivorSpecies);
+    const auto& species = speciation.GetSpecies();
+    parentGroups.assign(species.size(), {});
+    for (int g = 0; g < (int)genomes.size(); ++g) parentGroups[survivorSpecies[g]].push_back(records[g]);
+
+    // Shared fitness: each member's fitness divided by its species size,
+    // summed over the species, i.e. the species' mean fitness
+    parentGroupFitness.clear();
+    for (const auto& s : species) parentGroupFitness.push_back(s.MeanFitness());
+    stats.neatSpecies = (int)species.size();
+}
+
+// Picks a survivor to breed from, uniformly as before speciation, so the
+// mix of brain types carries over. When the pick is a NEAT brain and there
+// are several species, the NEAT share is redistributed: a species is drawn
+// in proportion to its shared fitness (NEAT's explicit fitness sharing),
+// so a fresh topology in a species of one is not outbred by a crowd of
+// established ones, then a member is drawn uniformly.
+int World::PickParent() {
+    int pick = rng.Index((int)savedGenetics.size());
+    if (parentGroups.size() <= 1 || !dynamic_cast<const NEATBrain*>(savedGenetics[pick].brain.get())) return pick;
+
+    float total = 0.0f;
+    for (float f : parentGroupFitness) total += f;
+    float draw = rng.Float01() * total;
+    size_t chosen = parentGroups.size() - 1;
+    for (size_t g = 0; g < parentGroups.size(); ++g) {
+        draw -= parentGroupFitness[g];
+        if (draw < 0.0f) { chosen = g; break; }
+    }
+    const std::vector<int>& group = parentGroups[chosen];
+    return group[rng.Index((int)group.size())];
 }
 
 void World::InitPopulation() {
-    agents.clear();
-    fruits.clear();
-    poisons.clear();
+    RefreshObstacles();
+    agents.Clear();
+    fruits.Clear();
+    poisons.Clear();
+    gridDirty = true;
     
     if(!savedGenetics.empty()) {
-        std::sort(savedGenetics.begin(), savedGenetics.end(), 
-                  [](const GeneticRecord& a, const GeneticRecord& b) {
-                      return a.fitness > b.fitness;
-                  });
-        
-        if (savedGenetics.size() > 30) {
-            savedGenetics.erase(savedGenetics.begin() + 30, savedGenetics.end());
-        }
-        
         // Scale population based on world size
-        int basePop = 120;
-        if (Config::CURRENT_SIZE == Config::SimSize::Small) basePop = 60;
-        else if (Config::CURRENT_SIZE == Config::SimSize::Large) basePop = 200;
-        else if (Config::CURRENT_SIZE == Config::SimSize::Huge) basePop = 350;
+        int basePop = InitialPopulation();
 
         int totalAgents = basePop;
         int randomAgents = totalAgents / 10;
@@ -310,293 +351,445 @@ void World::InitPopulation() {
         
         // Elite preservation - use safe spawn
         for(int i = 0; i < eliteAgents && i < savedGenetics.size(); i++) {
-            Vector2 startPos = FindSafeSpawnPosition(15.0f);
-            agents.emplace_back(startPos, *savedGenetics[i].brain, savedGenetics[i].phenotype);
+            Vec2 startPos = FindSafeSpawnPosition(15.0f);
+            agents.Add(Agent(startPos, *savedGenetics[i].brain, savedGenetics[i].phenotype, rng));
         }
         
         // Weak mutation - use safe spawn
         for(int i = 0; i < weakMutationAgents; i++) {
-            Vector2 startPos = FindSafeSpawnPosition(15.0f);
-            int parentIdx = (int)RandomFloat(0, savedGenetics.size());
+            Vec2 startPos = FindSafeSpawnPosition(15.0f);
+            int parentIdx = PickParent();
             std::unique_ptr<IBrain> childBrain = savedGenetics[parentIdx].brain->Clone();
-            childBrain->Mutate(0.15f, 0.08f);
+            childBrain->Mutate(0.15f, 0.08f, rng);
             Phenotype childPheno = savedGenetics[parentIdx].phenotype;
-            childPheno.Mutate(0.1f);
-            agents.emplace_back(startPos, *childBrain, childPheno);
+            childPheno.Mutate(0.1f, rng);
+            agents.Add(Agent(startPos, *childBrain, childPheno, rng));
         }
         
         // Strong mutation - use safe spawn
         for(int i = 0; i < strongMutationAgents; i++) {
-            Vector2 startPos = FindSafeSpawnPosition(15.0f);
-            int parentIdx = (int)RandomFloat(0, savedGenetics.size());
+            Vec2 startPos = FindSafeSpawnPosition(15.0f);
+            int parentIdx = PickParent();
             std::unique_ptr<IBrain> childBrain = savedGenetics[parentIdx].brain->Clone();
-            childBrain->Mutate(0.3f, 0.25f);
+            childBrain->Mutate(0.3f, 0.25f, rng);
             Phenotype childPheno = savedGenetics[parentIdx].phenotype;
-            childPheno.Mutate(0.3f);
-            agents.emplace_back(startPos, *childBrain, childPheno);
+            childPheno.Mutate(0.3f, rng);
+            agents.Add(Agent(startPos, *childBrain, childPheno, rng));
         }
         
         // Random agents - use safe spawn
         for(int i = 0; i < randomAgents; i++) {
-            Vector2 startPos = FindSafeSpawnPosition(15.0f);
-            agents.emplace_back(startPos);
+            Vec2 startPos = FindSafeSpawnPosition(15.0f);
+            agents.Add(Agent(startPos, rng));
         }
         
         savedGenetics.clear();
     }
     else {
-        int basePop = 120;
-        if (Config::CURRENT_SIZE == Config::SimSize::Small) basePop = 60;
-        else if (Config::CURRENT_SIZE == Config::SimSize::Large) basePop = 200;
-        else if (Config::CURRENT_SIZE == Config::SimSize::Huge) basePop = 350;
+        int basePop = InitialPopulation();
         // First generation - ALSO use safe spawn positions
         for(int i=0; i<basePop; i++) {
-            Vector2 startPos = FindSafeSpawnPosition(15.0f);
-            agents.emplace_back(startPos);
+            Vec2 startPos = FindSafeSpawnPosition(15.0f);
+            agents.Add(Agent(startPos, rng));
         }
     }
     
     // Spawn fruits/poison scaled
-    int baseFruits = 100;
-    int basePoison = 20;
+    int baseFruits = Config::SizedCount(50, 100, 150, 250);
+    int basePoison = Config::SizedCount(10, 20, 40, 80);
 
-    if (Config::CURRENT_SIZE == Config::SimSize::Small) { baseFruits = 50; basePoison = 10; }
-    else if (Config::CURRENT_SIZE == Config::SimSize::Large) { baseFruits = 150; basePoison = 40; }
-    else if (Config::CURRENT_SIZE == Config::SimSize::Huge) { baseFruits = 250; basePoison = 80; }
+    fruits.Reserve(baseFruits);
+    poisons.Reserve(basePoison);
 
     for(int i=0; i<baseFruits; i++) {
-        Vector2 pos = FindSafeSpawnPosition(5.0f, 30);
-        fruits.push_back({pos});
+        Vec2 pos = FindSafeSpawnPosition(5.0f, 30);
+        fruits.Spawn({pos});
     }
     
     for(int i=0; i<basePoison; i++) {
-        Vector2 pos = FindSafeSpawnPosition(5.0f, 30);
-        poisons.push_back({pos});
+        Vec2 pos = FindSafeSpawnPosition(5.0f, 30);
+        poisons.Spawn({pos});
     }
     
     stats.generation++;
+    innovations->BeginGeneration();
     stats.avgFitness = 0.0f;
     stats.bestFitness = 0.0f;
 }
 
-template <typename T>
-void World::CleanupEntities(std::vector<T>& entities) {
-    entities.erase(std::remove_if(entities.begin(), entities.end(), 
-                   [](const T& e) { return !e.active; }), entities.end());
+void World::CleanupAgents() {
+    // Dead agents are swapped with the last one and popped, so a death costs
+    // O(1) rather than shifting everyone behind it. Survivors keep their
+    // AgentId; only dense indices move, and the linked layers move with them.
+    for (GridLayer* layer : {&grid.agents, &visionGrid.agents}) {
+        if (layer->Linked() && layer->Tracked() > (int)agents.size()) gridDirty = true;
+    }
+    int i = 0;
+    while (i < (int)agents.size()) {
+        if (agents.active[i]) { ++i; continue; }
+        for (GridLayer* layer : {&grid.agents, &visionGrid.agents}) {
+            if (gridDirty || !layer->Linked() || i >= layer->Tracked()) continue;
+            // The agent moving in is only tracked if nothing was appended
+            // since the last sync; otherwise the next SyncGrid() links it
+            if (layer->Tracked() == (int)agents.size()) layer->SwapRemove(i);
+            else layer->Remove(i);
+        }
+        agents.SwapRemove(i); // Recheck i: the agent moved into it may be dead too
+    }
 }
 
-SensorData World::ScanSurroundings(Agent& agent) {
+SensorData World::ScanSurroundings(int i) {
     SensorData data;
-    float minFruitDistSqr = Config::AGENT_VISION_RADIUS * Config::AGENT_VISION_RADIUS;
-    float minPoisonDistSqr = minFruitDistSqr;
-    float minObstacleDistSqr = minFruitDistSqr;
-    
-    int gx = (int)agent.pos.x / Config::GRID_CELL_SIZE;
-    int gy = (int)agent.pos.y / Config::GRID_CELL_SIZE;
-    int range = (int)(Config::AGENT_VISION_RADIUS / Config::GRID_CELL_SIZE) + 1;
-
-    agent.targetFruit = {-1, -1};
-    agent.targetPoison = {-1, -1};
-    
-    bool sawPoison = false;
-
-    for (int x = gx - range; x <= gx + range; x++) {
-        for (int y = gy - range; y <= gy + range; y++) {
-            if (x < 0 || x >= Config::GRID_W || y < 0 || y >= Config::GRID_H) continue;
-
-            for (int idx : grid.fruitIndices[grid.GetCellIndex(x, y)]) {
-                if (!fruits[idx].active) continue;
-                float dSqr = Vector2DistanceSqr(agent.pos, fruits[idx].pos);
-                if (dSqr < minFruitDistSqr) {
-                    minFruitDistSqr = dSqr;
-                    agent.targetFruit = fruits[idx].pos;
-                    float angleTo = atan2(fruits[idx].pos.y - agent.pos.y, fruits[idx].pos.x - agent.pos.x);
-                    data.fruitAngle = NormalizeAngle(angleTo - agent.angle) / PI;
-                    data.fruitDist = sqrt(dSqr) / Config::AGENT_VISION_RADIUS;
-                }
-            }
-            
+    const float vision = Config::AGENT_VISION_RADIUS;
+    const Vec2 pos = agents.pos[i];
+    const float heading = agents.angle[i];
+    AgentTrace& trace = agents.trace[i];
 
-            
-            for (int idx : grid.poisonIndices[grid.GetCellIndex(x, y)]) {
-                if (!poisons[idx].active) continue;
-                float dSqr = Vector2DistanceSqr(agent.pos, poisons[idx].pos);
-                if (dSqr < minPoisonDistSqr) {
-                    minPoisonDistSqr = dSqr;
-                    agent.targetPoison = poisons[idx].pos;
-                    float angleTo = atan2(poisons[idx].pos.y - agent.pos.y, poisons[idx].pos.x - agent.pos.x);
-                    data.poisonAngle = NormalizeAngle(angleTo - agent.angle) / PI;
-                    data.poisonDist = sqrt(dSqr) / Config::AGENT_VISION_RADIUS;
-                    sawPoison = true;
-                }
-            }
-        }
+    trace.targetFruit = {-1, -1};
+    trace.targetPoison = {-1, -1};
+    
+    // Fruit and poison never move, so the grid's inline positions are exact;
+    // only the active flag (cleared when eaten this tick) needs the entity
+    NearestHit fruit = visionGrid.NearestWrapped(visionGrid.fruits, pos, vision, [&](int idx) { return fruits[idx].active; });
+    if (fruit.index >= 0) {
+        trace.targetFruit = fruit.pos;
+        float angleTo = atan2(fruit.pos.y - pos.y, fruit.pos.x - pos.x);
+        data.fruitAngle = NormalizeAngle(angleTo - heading) / Math::Pi;
+        data.fruitDist = sqrt(fruit.distSqr) / vision;
     }
     
-    // Improved obstacle detection - check all obstacles
-    float visionRadiusSqr = Config::AGENT_VISION_RADIUS * Config::AGENT_VISION_RADIUS;
-    for (const auto& obs : obstacles) {
-        if (!obs.active) continue;
-        
-        Vector2 center = {obs.pos.x + obs.size.x / 2, obs.pos.y + obs.size.y / 2};
-        float dSqr = Vector2DistanceSqr(agent.pos, center);
-        
-        if (dSqr < visionRadiusSqr && dSqr < minObstacleDistSqr) {
-            minObstacleDistSqr = dSqr;
-            float angleTo = atan2(center.y - agent.pos.y, center.x - agent.pos.x);
-            data.obstacleAngle = NormalizeAngle(angleTo - agent.angle) / PI;
-            data.obstacleDist = sqrt(dSqr) / Config::AGENT_VISION_RADIUS;
+    NearestHit poison = visionGrid.NearestWrapped(visionGrid.poisons, pos, vision, [&](int idx) { return poisons[idx].active; });
+    bool sawPoison = poison.index >= 0;
+    if (sawPoison) {
+        trace.targetPoison = poison.pos;
+        float angleTo = atan2(poison.pos.y - pos.y, poison.pos.x - pos.x);
+        data.poisonAngle = NormalizeAngle(angleTo - heading) / Math::Pi;
+        data.poisonDist = sqrt(poison.distSqr) / vision;
+    }
+    
+    if (Config::OBSTACLE_SDF) {
+        // Nearest surface: the field gives its distance, and it lies against the gradient
+        ObstacleField::Sample s = obstacleField.Lookup(pos);
+        if (s.distance < vision && (s.gradient.x != 0.0f || s.gradient.y != 0.0f)) {
+            float angleTo = atan2(-s.gradient.y, -s.gradient.x);
+            data.obstacleAngle = NormalizeAngle(angleTo - heading) / Math::Pi;
+            data.obstacleDist = std::max(0.0f, s.distance) / vision;
+        }
+    } else {
+        // Without the distance field, obstacles are sensed by their centre
+        NearestHit obstacle = visionGrid.Nearest(visionGrid.obstacleCenters, pos, vision, [](int) { return true; });
+        if (obstacle.index >= 0) {
+            float angleTo = atan2(obstacle.pos.y - pos.y, obstacle.pos.x - pos.x);
+            data.obstacleAngle = NormalizeAngle(angleTo - heading) / Math::Pi;
+            data.obstacleDist = sqrt(obstacle.distSqr) / vision;
         }
     }
     
     // Pheromone Detection
-    // Check neighbors in grid, simpler than all agents
+    // Only nearby agents count, so this is a short radius query on the vision grid
     float pheromoneSum = 0.0f;
     int nearbyCount = 0;
+    float pheromoneRadius = std::min(Config::PHEROMONE_RADIUS, vision);
+    float pheromoneRadiusSqr = pheromoneRadius * pheromoneRadius;
     
-    for (int x = gx - 1; x <= gx + 1; x++) {
-        for (int y = gy - 1; y <= gy + 1; y++) {
-             if (x < 0 || x >= Config::GRID_W || y < 0 || y >= Config::GRID_H) continue;
-             for (int idx : grid.agentIndices[grid.GetCellIndex(x, y)]) {
-                 Agent& other = agents[idx];
-                 if (&other == &agent || !other.active) continue;
-                 
-                 float dSqr = Vector2DistanceSqr(agent.pos, other.pos);
-                 if (dSqr < visionRadiusSqr) {
-                     // Strength falls off with distance
-                     float dist = sqrt(dSqr);
-                     float strength = other.pheromoneEmission * (1.0f - (dist / Config::AGENT_VISION_RADIUS));
-                     pheromoneSum += std::max(0.0f, strength);
-                     nearbyCount++;
-                 }
-             }
+    visionGrid.ForEachInRadiusWrapped(visionGrid.agents, pos, pheromoneRadius + GRID_SLACK, [&](int idx, Vec2, Vec2 offset) {
+        // Agents move during the tick; read the live position, not the inline one
+        if (idx == i || !agents.active[idx]) return;
+        
+        float dSqr = Vec2DistanceSqr(pos, Vec2Add(agents.pos[idx], offset));
+        if (dSqr < pheromoneRadiusSqr) {
+            // Strength falls off with distance
+            float dist = sqrt(dSqr);
+            float strength = agents.pheromoneEmission[idx] * (1.0f - (dist / vision));
+            pheromoneSum += std::max(0.0f, strength);
+            nearbyCount++;
         }
-    }
+    });
     // Normalize input
     data.pheromoneIntensity = std::tanh(pheromoneSum);
     
     if (sawPoison) {
-        agent.poisonsAvoided++;
+        agents.life[i].poisonsAvoided++;
     }
     
     return data;
 }
 
-void World::HandleInteractions(Agent& agent, std::vector<Agent>& babies) {
+void World::HandleInteractions(int i, std::vector<Agent>& babies) {
     float eatRadiusSqr = Config::EAT_RADIUS * Config::EAT_RADIUS; 
-    int gx = (int)agent.pos.x / Config::GRID_CELL_SIZE;
-    int gy = (int)agent.pos.y / Config::GRID_CELL_SIZE;
+    float queryRadius = Config::EAT_RADIUS + GRID_SLACK;
+    const Vec2 pos = agents.pos[i];
+    const Phenotype& phenotype = agents.phenotype[i];
+    float& energy = agents.energy[i];
+    AgentLife& life = agents.life[i];
     
     float reward = 0.0f;
 
-    for(int x = gx-1; x <= gx+1; x++) {
-        for(int y = gy-1; y <= gy+1; y++) {
-            if (x < 0 || x >= Config::GRID_W || y < 0 || y >= Config::GRID_H) continue;
+    grid.ForEachInRadiusWrapped(grid.fruits, pos, queryRadius, [&](int idx, Vec2 fpos, Vec2) {
+        if (Vec2DistanceSqr(pos, fpos) < eatRadiusSqr && fruits[idx].active) {
+            float energyGain = Config::FRUIT_ENERGY;
+            if(phenotype.species == Species::Herbivore) energyGain *= Config::HERBIVORE_FRUIT_BONUS; // Bonus
+            else if(phenotype.species == Species::Predator) energyGain *= 0.5f; // Penalty (Hardcoded penalty for now, could be config)
             
-            for (int idx : grid.fruitIndices[grid.GetCellIndex(x, y)]) {
-                if (fruits[idx].active && Vector2DistanceSqr(agent.pos, fruits[idx].pos) < eatRadiusSqr) {
-                    float energyGain = Config::FRUIT_ENERGY;
-                    if(agent.phenotype.species == Species::Herbivore) energyGain *= Config::HERBIVORE_FRUIT_BONUS; // Bonus
-                    else if(agent.phenotype.species == Species::Predator) energyGain *= 0.5f; // Penalty (Hardcoded penalty for now, could be config)
-                    
-                    agent.energy = std::min(agent.energy + energyGain, Config::AGENT_MAX_ENERGY);
-                    fruits[idx].active = false;
-                    agent.fruitsEaten++;
-                    reward += 1.0f;
-                }
+            energy = std::min(energy + energyGain, Config::AGENT_MAX_ENERGY);
+            fruits.Release(idx);
+            life.fruitsEaten++;
+            reward += 1.0f;
+        }
+    });
+    
+
+    
+    grid.ForEachInRadiusWrapped(grid.poisons, pos, queryRadius, [&](int idx, Vec2 ppos, Vec2) {
+        if (Vec2DistanceSqr(pos, ppos) < eatRadiusSqr && poisons[idx].active) {
+            if(phenotype.species == Species::Scavenger) {
+                // Scavengers eat poison as food!
+                energy = std::min(energy + Config::FRUIT_ENERGY * Config::SCAVENGER_POISON_GAIN, Config::AGENT_MAX_ENERGY);
+                reward += 1.0f;
+            } else {
+                float damage = Config::POISON_DAMAGE;
+                if(phenotype.species == Species::Herbivore) damage *= 1.2f; // Extra sensitive
+                energy -= damage;
+                life.poisonsAvoided = std::max(0, life.poisonsAvoided - 5);
+                reward -= 2.0f;
             }
-            
+            poisons.Release(idx);
+        }
+    });
+    
 
+    
+    // Interaction with other agents (Mating / Hunting)
+    bool keepGoing = grid.ForEachInRadiusWrapped(grid.agents, pos, queryRadius, [&](int idx, Vec2, Vec2 offset) {
+        if (idx == i || !agents.active[idx]) return true;
+        const Phenotype& otherPhenotype = agents.phenotype[idx];
+        float& otherEnergy = agents.energy[idx];
+        
+        // The other agent's image nearest this one, across the wrap if need be
+        Vec2 otherPos = Vec2Add(agents.pos[idx], offset);
+        float dSqr = Vec2DistanceSqr(pos, otherPos);
+        if (dSqr < eatRadiusSqr) { // Contact range
             
-            for (int idx : grid.poisonIndices[grid.GetCellIndex(x, y)]) {
-                if (poisons[idx].active && Vector2DistanceSqr(agent.pos, poisons[idx].pos) < eatRadiusSqr) {
-                    if(agent.phenotype.species == Species::Scavenger) {
-                        // Scavengers eat poison as food!
-                        agent.energy = std::min(agent.energy + Config::FRUIT_ENERGY * Config::SCAVENGER_POISON_GAIN, Config::AGENT_MAX_ENERGY);
-                        reward += 1.0f;
-                    } else {
-                        float damage = Config::POISON_DAMAGE;
-                        if(agent.phenotype.species == Species::Herbivore) damage *= 1.2f; // Extra sensitive
-                        agent.energy -= damage;
-                        agent.poisonsAvoided = std::max(0, agent.poisonsAvoided - 5);
-                        reward -= 2.0f;
-                    }
-                    poisons[idx].active = false;
+            // Predator Hunting logic
+            if (phenotype.species == Species::Predator && otherPhenotype.species != Species::Predator) {
+                // Steal energy
+                float stealAmount = Config::PREDATOR_STEAL_AMOUNT * Config::METABOLISM_RATE * 0.1f; // Bite
+                if (energy < Config::AGENT_MAX_ENERGY) {
+                    energy += stealAmount;
+                    otherEnergy -= stealAmount * 1.5f; // Victim loses more
+                    reward += 0.5f;
                 }
             }
             
-
-            
-            // Interaction with other agents (Mating / Hunting)
-            for (int idx : grid.agentIndices[grid.GetCellIndex(x, y)]) {
-                Agent& other = agents[idx];
-                if (&other == &agent || !other.active) continue;
-                
-                float dSqr = Vector2DistanceSqr(agent.pos, other.pos);
-                if (dSqr < eatRadiusSqr) { // Contact range
-                    
-                    // Predator Hunting logic
-                    if (agent.phenotype.species == Species::Predator && other.phenotype.species != Species::Predator) {
-                        // Steal energy
-                        float stealAmount = Config::PREDATOR_STEAL_AMOUNT * Config::METABOLISM_RATE * 0.1f; // Bite
-                        if (agent.energy < Config::AGENT_MAX_ENERGY) {
-                            agent.energy += stealAmount;
-                            other.energy -= stealAmount * 1.5f; // Victim loses more
-                            reward += 0.5f;
+            // Mating Logic (Requires same species)
+            if (agents.sex[i] == Sex::Female && energy > Config::MATING_ENERGY_THRESHOLD && agents.sex[idx] == Sex::Male && otherEnergy > Config::MATING_ENERGY_THRESHOLD) {
+                 // Only mate with same species to keep distinct lines? Or allow hybridization?
+                 // Let's encourage same species mating for specialization stability.
+                 if (phenotype.species == otherPhenotype.species) {
+                    if (dSqr < (Config::MATING_RANGE * Config::MATING_RANGE)) {
+                        energy -= Config::MATING_ENERGY_COST;
+                        otherEnergy -= Config::MATING_ENERGY_COST;
+                        
+                        Rng& motherRng = agents.rng[i];
+                        Vec2 childBasePos = WrapToWorld(Vec2Scale(Vec2Add(pos, otherPos), 0.5f));
+                        Vec2 childPos = childBasePos;
+                        for (int attempt = 0; attempt < 10; ++attempt) {
+                            Vec2 testPos = { childBasePos.x + RandomFloat(motherRng, -30, 30), childBasePos.y + RandomFloat(motherRng, -30, 30) };
+                            if (!CheckObstacleCollision(testPos, 10.0f)) { childPos = testPos; break; }
                         }
+                        
+                        // Offspring draw from the mother's stream
+                        Agent child(childPos, motherRng);
+                        child.brain = agents.brain[i]->Crossover(*agents.brain[idx], motherRng);
+                        child.brain->Mutate(Config::CHILD_BRAIN_MUTATION_RATE, Config::CHILD_BRAIN_MUTATION_POWER, motherRng);
+                        child.phenotype = Phenotype::Crossover(phenotype, otherPhenotype, motherRng);
+                        child.phenotype.Mutate(Config::CHILD_PHENOTYPE_MUTATION_RATE, motherRng);
+                        babies.push_back(std::move(child)); // Use move
+                        
+                        life.childrenCount++;
+                        agents.life[idx].childrenCount++;
+                        reward += 2.0f; // High reward for reproduction
+                        return false; // One baby per frame per mom
                     }
-                    
-                    // Mating Logic (Requires same species)
-                    if (agent.sex == Sex::Female && agent.energy > Config::MATING_ENERGY_THRESHOLD && other.sex == Sex::Male && other.energy > Config::MATING_ENERGY_THRESHOLD) {
-                         // Only mate with same species to keep distinct lines? Or allow hybridization?
-                         // Let's encourage same species mating for specialization stability.
-                         if (agent.phenotype.species == other.phenotype.species) {
-                            if (Vector2DistanceSqr(agent.pos, other.pos) < (Config::MATING_RANGE * Config::MATING_RANGE)) {
-                                agent.energy -= Config::MATING_ENERGY_COST;
-                                other.energy -= Config::MATING_ENERGY_COST;
-                                
-                                Vector2 childBasePos = Vector2Scale(Vector2Add(agent.pos, other.pos), 0.5f);
-                                Vector2 childPos = childBasePos;
-                                for (int attempt = 0; attempt < 10; ++attempt) {
-                                    Vector2 testPos = { childBasePos.x + RandomFloat(-30, 30), childBasePos.y + RandomFloat(-30, 30) };
-                                    if (!CheckObstacleCollision(testPos, 10.0f)) { childPos = testPos; break; }
-                                }
-                                
-                                Agent child(childPos);
-                                child.brain = agent.brain->Crossover(*other.brain);
-                                child.brain->Mutate(Config::CHILD_BRAIN_MUTATION_RATE, Config::CHILD_BRAIN_MUTATION_POWER);
-                                child.phenotype = Phenotype::Crossover(agent.phenotype, other.phenotype);
-                                child.phenotype.Mutate(Config::CHILD_PHENOTYPE_MUTATION_RATE);
-                                babies.push_back(std::move(child)); // Use move
-                                
-                                agent.childrenCount++;
-                                other.childrenCount++;
-                                reward += 2.0f; // High reward for reproduction
-                                return; // One baby per frame per mom
-                            }
-                         }
-                    }
-                }
+                 }
             }
         }
-    }
+        return true;
+    });
+    if (!keepGoing) return;
     
     if (Config::ENABLE_LIFETIME_LEARNING && reward != 0.0f) {
-        agent.totalReward += reward;
-        agent.brain->LearnFromReward(reward, Config::LEARNING_RATE);
+        life.totalReward += reward;
+        agents.brain[i]->LearnFromReward(reward, Config::LEARNING_RATE);
+        agents.MarkBrainChanged(i);
+    }
+}
+
+void World::FillGrid(SpatialGrid& g) const {
+    g.Clear();
+    for(size_t i=0; i<fruits.size(); ++i) if(fruits[i].active) g.AddFruit(i, fruits[i].pos);
+    for(size_t i=0; i<poisons.size(); ++i) if(poisons[i].active) g.AddPoison(i, poisons[i].pos);
+    for(size_t i=0; i<agents.size(); ++i) if(agents.active[i]) g.AddAgent(i, agents.pos[i]);
+    for(size_t i=0; i<obstacles.size(); ++i) if(obstacles[i].active) g.AddObstacle(i, obstacles[i].pos, obstacles[i].size);
+    g.Build();
+}
+
+void World::RebuildGrid() {
+    FillGrid(grid);
+    FillGrid(visionGrid);
+}
+
+void World::ConfigureGrids() {
+    int contactCell = Config::CONTACT_CELL_SIZE;
+    int visionCell = Config::VISION_CELL_SIZE;
+    if (Config::AUTO_GRID_CELLS) {
+        // Contact queries span the eat radius plus slack, i.e. a 3x3 block.
+        // Vision cells are a whole multiple of contact cells about half the
+        // vision radius wide, so ring searches stop after a couple of rings.
+        contactCell = std::max(8, (int)std::ceil(Config::EAT_RADIUS + GRID_SLACK));
+        int ratio = std::max(1, (int)std::lround(Config::AGENT_VISION_RADIUS * 0.5f / contactCell));
+        visionCell = contactCell * ratio;
+    }
+    bool changed = grid.Configure(contactCell, Config::WORLD_W, Config::WORLD_H);
+    changed |= visionGrid.Configure(visionCell, Config::WORLD_W, Config::WORLD_H);
+    if (changed) {
+        gridDirty = true;
+        obstaclesDirty = true;
+    }
+}
+
+namespace {
+// Fruits and poisons never move: a slot only needs relinking when an item
+// was eaten out of it or respawned into it
+template <typename T>
+void LinkChanged(GridLayer& layer, const EntityPool<T>& pool, const SpatialGrid& grid) {
+    for (int i = layer.Tracked(); i < (int)pool.size(); ++i) {
+        layer.Append(pool[i].active ? grid.CellOf(pool[i].pos) : -1, pool[i].pos);
+    }
+    for (int i : pool.Changed()) {
+        layer.Move(i, pool[i].active ? grid.CellOf(pool[i].pos) : -1, pool[i].pos);
+    }
+}
+}
+
+void World::RefreshObstacles() {
+    // Obstacles are static: re-rasterize and re-bake only when a generator
+    // replaced them or the map or cell sizes changed
+    ConfigureGrids();
+    bool fieldStale = !obstacleField.Matches(Config::WORLD_W, Config::WORLD_H, Config::SDF_CELL_SIZE, Config::SdfBand());
+    if (!obstaclesDirty && !fieldStale) return;
+
+    for (SpatialGrid* g : {&grid, &visionGrid}) {
+        g->obstacles.Reset(g->NumCells());
+        g->obstacleCenters.Reset(g->NumCells());
+        for(size_t i=0; i<obstacles.size(); ++i) if(obstacles[i].active) g->AddObstacle(i, obstacles[i].pos, obstacles[i].size);
+        g->obstacles.Build();
+        g->obstacleCenters.Build();
+    }
+    obstacleField.Bake(obstacles, Config::WORLD_W, Config::WORLD_H, Config::SDF_CELL_SIZE, Config::SdfBand());
+    obstaclesDirty = false;
+}
+
+void World::SyncGrid() {
+    RefreshObstacles();
+    if (!Config::INCREMENTAL_GRID) {
+        RebuildGrid();
+        fruits.ClearChanged();
+        poisons.ClearChanged();
+        return;
+    }
+
+    for (SpatialGrid* g : {&grid, &visionGrid}) {
+        if (!g->agents.Linked() ||
+            g->agents.Tracked() > (int)agents.size() ||
+            g->fruits.Tracked() > (int)fruits.size() ||
+            g->poisons.Tracked() > (int)poisons.size()) {
+            gridDirty = true;
+        }
+    }
+
+    for (SpatialGrid* g : {&grid, &visionGrid}) {
+        if (gridDirty) {
+            g->fruits.ResetLinked(g->NumCells());
+            g->poisons.ResetLinked(g->NumCells());
+            g->agents.ResetLinked(g->NumCells());
+        }
+
+        LinkChanged(g->fruits, fruits, *g);
+        LinkChanged(g->poisons, poisons, *g);
+
+        // Agents are only relinked when they cross into another cell
+        int tracked = g->agents.Tracked();
+        for (int i = 0; i < tracked; ++i) {
+            Vec2 pos = agents.pos[i];
+            g->agents.Move(i, agents.active[i] ? g->CellOf(pos) : -1, pos);
+        }
+        for (int i = tracked; i < (int)agents.size(); ++i) {
+            g->agents.Append(agents.active[i] ? g->CellOf(agents.pos[i]) : -1, agents.pos[i]);
+        }
     }
+    fruits.ClearChanged();
+    poisons.ClearChanged();
+    gridDirty = false;
+}
+
+namespace {
+// Compares one layer cell by cell against a batch-built reference. Inactive
+// entities may linger in a linked layer until the next cleanup, so they are
+// ignored; queries skip them anyway.
+template <typename IsActive>
+bool SameLayer(const char* name, const GridLayer& layer, const GridLayer& reference, IsActive isActive) {
+    if (layer.NumCells() != reference.NumCells()) {
+        std::fprintf(stderr, "grid validation: %s layer has %d cells, expected %d\n", name, layer.NumCells(), reference.NumCells());
+        return false;
+    }
+    std::vector<int> got, want;
+    for (int c = 0; c < reference.NumCells(); ++c) {
+        got.clear();
+        want.clear();
+        layer.ForEach(c, [&](int idx, Vec2) { if (isActive(idx)) got.push_back(idx); });
+        reference.ForEach(c, [&](int idx, Vec2) { want.push_back(idx); });
+        std::sort(got.begin(), got.end());
+        std::sort(want.begin(), want.end());
+        if (got != want) {
+            std::fprintf(stderr, "grid validation: %s layer differs in cell %d (%zu entries, expected %zu)\n",
+                         name, c, got.size(), want.size());
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+bool World::ValidateGrid() const {
+    bool ok = true;
+    for (const SpatialGrid* g : {&grid, &visionGrid}) {
+        SpatialGrid reference;
+        reference.Configure(g->CellSize(), Config::WORLD_W, Config::WORLD_H);
+        FillGrid(reference);
+        ok &= SameLayer("fruit", g->fruits, reference.fruits, [&](int i) { return fruits[i].active; });
+        ok &= SameLayer("poison", g->poisons, reference.poisons, [&](int i) { return poisons[i].active; });
+        ok &= SameLayer("agent", g->agents, reference.agents, [&](int i) { return agents.active[i] != 0; });
+        ok &= SameLayer("obstacle", g->obstacles, reference.obstacles, [&](int i) { return obstacles[i].active; });
+        ok &= SameLayer("obstacle centre", g->obstacleCenters, reference.obstacleCenters, [&](int i) { return obstacles[i].active; });
+    }
+    return ok;
 }
 
 void World::Update(float dt) {
+    profiler.BeginTick();
     stats.time += dt;
 
-    UpdateSeasons(dt);
+    {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Seasons);
+        UpdateSeasons(dt);
+    }
     
-    grid.Clear();
-    for(size_t i=0; i<fruits.size(); ++i) if(fruits[i].active) grid.AddFruit(i, fruits[i].pos);
-    for(size_t i=0; i<poisons.size(); ++i) if(poisons[i].active) grid.AddPoison(i, poisons[i].pos);
-    for(size_t i=0; i<agents.size(); ++i) if(agents[i].active) grid.AddAgent(i, agents[i].pos);
-    for(size_t i=0; i<obstacles.size(); ++i) if(obstacles[i].active) grid.AddObstacle(i, obstacles[i].pos, obstacles[i].size);
+    {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::GridRebuild);
+        SyncGrid();
+    }
+    if (Config::VALIDATE_GRID && !ValidateGrid()) gridValidationErrors++;
 
     std::vector<Agent> babies;
     
@@ -611,24 +804,51 @@ void World::Update(float dt) {
     int cNEAT = 0;
     int cNN = 0;
 
-    for(auto& agent : agents) {
-        if (!agent.active) continue;
+    {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Agents);
+        agents.SnapshotPrevious();
+
+        // Stats pass over the phenotype and brain columns. Agents only
+        // deactivate themselves, so this sees the same set the update loop does.
+        int count = (int)agents.size();
+        for (int i = 0; i < count; ++i) {
+            if (!agents.active[i]) continue;
+            const Phenotype& p = agents.phenotype[i];
         
-        activeCount++;
-        totalSpeed += agent.phenotype.speed;
-        totalSize += agent.phenotype.size;
-        totalEfficiency += agent.phenotype.efficiency;
+            activeCount++;
+            totalSpeed += p.speed;
+            totalSize += p.size;
+            totalEfficiency += p.efficiency;
         
-        if (agent.phenotype.species == Species::Herbivore) herbs++;
-        else if (agent.phenotype.species == Species::Scavenger) scavs++;
-        else if (agent.phenotype.species == Species::Predator) preds++;
+            if (p.species == Species::Herbivore) herbs++;
+            else if (p.species == Species::Scavenger) scavs++;
+            else if (p.species == Species::Predator) preds++;
         
-        std::string bType = agent.brain->GetType();
-        if (bType == "RNN") cRNN++;
-        else if (bType == "NEAT") cNEAT++;
-        else cNN++;
+            std::string bType = agents.brain[i]->GetType();
+            if (bType == "RNN") cRNN++;
+            else if (bType == "NEAT") cNEAT++;
+            else cNN++;
+        }
 
-        UpdateAgent(agent, dt, babies);
+        // Sense, think, act as separate passes: everyone senses the world as
+        // it was at the start of the tick, and the think pass sees the whole
+        // population at once so same-shape brains can be evaluated together
+        brainInputs.resize((size_t)count * BRAIN_INPUTS);
+        brainOutputs.resize((size_t)count * BRAIN_OUTPUTS);
+        {
+            MC_PROFILE_SCOPE(profiler, ProfPhase::Sense);
+            for (int i = 0; i < count; ++i) {
+                if (agents.active[i]) SenseAgent(i, dt, std::span(brainInputs).subspan((size_t)i * BRAIN_INPUTS, BRAIN_INPUTS));
+            }
+        }
+        {
+            MC_PROFILE_SCOPE(profiler, ProfPhase::Think);
+            brainBatch.Run(agents.brain, agents.active, agents.BrainChanged(), brainInputs, brainOutputs);
+            agents.ClearBrainChanged();
+        }
+        for (int i = 0; i < count; ++i) {
+            if (agents.active[i]) ActAgent(i, std::span(brainOutputs).subspan((size_t)i * BRAIN_OUTPUTS, BRAIN_OUTPUTS), dt, babies);
+        }
     }
     
     if (activeCount > 0) {
@@ -638,40 +858,46 @@ void World::Update(float dt) {
     }
 
     if (!babies.empty()) {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Births);
         stats.births += (int)babies.size();
-        agents.insert(agents.end(), std::make_move_iterator(babies.begin()), std::make_move_iterator(babies.end()));
+        for (Agent& baby : babies) agents.Add(std::move(baby));
     }
 
-    CleanupEntities(agents);
-    CleanupEntities(fruits);
-    CleanupEntities(poisons);
-
-    int fruitCap = 60;
-    int poisonCap = 15;
+    {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Cleanup);
+        CleanupAgents();
+    }
 
-    if (Config::CURRENT_SIZE == Config::SimSize::Small) { fruitCap = 30; poisonCap = 10; }
-    else if (Config::CURRENT_SIZE == Config::SimSize::Large) { fruitCap = 120; poisonCap = 30; }
-    else if (Config::CURRENT_SIZE == Config::SimSize::Huge) { fruitCap = 180; poisonCap = 50; }
+    int fruitCap = Config::SizedCount(30, 60, 120, 180);
+    int poisonCap = Config::SizedCount(10, 15, 30, 50);
     
     // Seasonal Effects
-    if (season.currentSeason == Season::Spring) { fruitCap = 120; }
-    else if (season.currentSeason == Season::Winter) { fruitCap = 20; }
-    else if (season.currentSeason == Season::Autumn) { fruitCap = 30; }
+    if (season.currentSeason == Season::Spring) { fruitCap = Config::SizedCount(120); }
+    else if (season.currentSeason == Season::Winter) { fruitCap = Config::SizedCount(20); }
+    else if (season.currentSeason == Season::Autumn) { fruitCap = Config::SizedCount(30); }
     
-    if (fruits.size() < (size_t)fruitCap) {
-        Vector2 pos = FindSafeSpawnPosition(5.0f, 30);
-        fruits.push_back({pos});
-    }
-    if (poisons.size() < (size_t)poisonCap) {
-        Vector2 pos = FindSafeSpawnPosition(5.0f, 30);
-        poisons.push_back({pos});
+    {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Respawn);
+        // One item per tick on the presets; custom worlds refill in proportion to their area
+        int respawn = Config::SizedCount(1);
+        for (int i = 0; i < respawn && fruits.Live() < fruitCap; ++i) {
+            Vec2 pos = FindSafeSpawnPosition(5.0f, 30);
+            fruits.Spawn({pos});
+        }
+        for (int i = 0; i < respawn && poisons.Live() < poisonCap; ++i) {
+            Vec2 pos = FindSafeSpawnPosition(5.0f, 30);
+            poisons.Spawn({pos});
+        }
     }
 
     if (agents.empty()) {
+        MC_PROFILE_SCOPE(profiler, ProfPhase::Generation);
         if (stats.deaths > 0) {
             stats.avgFitness = stats.totalFitness / stats.deaths;
         }
         
+        SpeciateSurvivors();
+
         // Record history
         stats.history.push_back({
             stats.avgFitness,
@@ -684,116 +910,131 @@ void World::Update(float dt) {
             preds,
             cRNN,
             cNEAT,
-            cNN
+            cNN,
+            stats.neatSpecies
         });
         
         InitPopulation();
         stats.totalFitness = 0.0f;
     }
     if (agents.size() > (size_t)stats.maxPop) stats.maxPop = (int)agents.size();
+    profiler.EndTick((int)agents.size());
 }
 
-void World::UpdateAgent(Agent& agent, float dt, std::vector<Agent>& babies) {
-    agent.lifespan += dt;
+void World::SenseAgent(int i, float dt, std::span<float> inputs) {
+    agents.life[i].lifespan += dt;
 
-    SensorData data = ScanSurroundings(agent);
+    SensorData data = ScanSurroundings(i);
     
     // Store detected pheromone for visualization/debugging if needed
-    agent.pheromoneDetected = data.pheromoneIntensity;
+    agents.trace[i].pheromoneDetected = data.pheromoneIntensity;
     
-    std::vector<float> inputs = {
-        data.fruitAngle, data.fruitDist, 
-        data.poisonAngle, data.poisonDist,
-        data.obstacleAngle, data.obstacleDist,
-        data.pheromoneIntensity
-    };
+    inputs[0] = data.fruitAngle;
+    inputs[1] = data.fruitDist;
+    inputs[2] = data.poisonAngle;
+    inputs[3] = data.poisonDist;
+    inputs[4] = data.obstacleAngle;
+    inputs[5] = data.obstacleDist;
+    inputs[6] = data.pheromoneIntensity;
+}
 
-    auto outputs = agent.brain->FeedForward(inputs);
+void World::ActAgent(int i, std::span<const float> outputs, float dt, std::vector<Agent>& babies) {
+    AgentLife& life = agents.life[i];
+    IBrain& brain = *agents.brain[i];
+    const Phenotype& phenotype = agents.phenotype[i];
+    Vec2& pos = agents.pos[i];
+    float& angle = agents.angle[i];
+    float& energy = agents.energy[i];
 
     float leftTrack = outputs[0];
     float rightTrack = outputs[1];
-    agent.pheromoneEmission = std::clamp(outputs[2], 0.0f, 1.0f); // Output 2 is Pheromone
+    agents.pheromoneEmission[i] = std::clamp(outputs[2], 0.0f, 1.0f); // Output 2 is Pheromone
     float rotSpeed = 3.0f;
-    float moveSpeed = 120.0f * agent.phenotype.GetActualSpeed();
+    float moveSpeed = 120.0f * phenotype.GetActualSpeed();
 
-    agent.angle += (leftTrack - rightTrack) * rotSpeed * dt;
-    Vector2 forward = { cos(agent.angle), sin(agent.angle) };
+    angle += (leftTrack - rightTrack) * rotSpeed * dt;
+    Vec2 forward = { cos(angle), sin(angle) };
     float throttle = std::clamp((leftTrack + rightTrack) / 2.0f, -0.2f, 1.0f);
 
-    Vector2 newPos = Vector2Add(agent.pos, Vector2Scale(forward, throttle * moveSpeed * dt));
+    Vec2 newPos = Vec2Add(pos, Vec2Scale(forward, throttle * moveSpeed * dt));
     
     // Check collision before moving
-    float agentRadius = agent.phenotype.GetVisualSize();
+    float agentRadius = phenotype.GetVisualSize();
     if (!CheckObstacleCollision(newPos, agentRadius)) {
-        agent.pos = newPos;
+        pos = newPos;
     } else {
         // Collision detected
-        agent.obstaclesHit++;
-        agent.energy -= Config::COLLISION_ENERGY_PENALTY; 
+        life.obstaclesHit++;
+        energy -= Config::COLLISION_ENERGY_PENALTY; 
         
         if (Config::ENABLE_LIFETIME_LEARNING) {
-            agent.brain->LearnFromReward(-1.0f, Config::LEARNING_RATE * Config::COLLISION_LEARNING_BOOST);
+            brain.LearnFromReward(-1.0f, Config::LEARNING_RATE * Config::COLLISION_LEARNING_BOOST);
+            agents.MarkBrainChanged(i);
         }
         
         // Sliding logic
-        Vector2 slideDir = {-forward.y, forward.x};
-        Vector2 slidePos1 = Vector2Add(agent.pos, Vector2Scale(slideDir, throttle * moveSpeed * dt * 0.5f));
-        Vector2 slidePos2 = Vector2Add(agent.pos, Vector2Scale(slideDir, -throttle * moveSpeed * dt * 0.5f));
-        
-        if (!CheckObstacleCollision(slidePos1, agentRadius)) {
-            agent.pos = slidePos1;
-        } else if (!CheckObstacleCollision(slidePos2, agentRadius)) {
-            agent.pos = slidePos2;
+        if (Config::OBSTACLE_SDF) {
+            // Drop the part of the step that points into the wall and keep the tangential rest
+            Vec2 normal = obstacleField.Lookup(newPos).gradient;
+            Vec2 step = Vec2Subtract(newPos, pos);
+            float into = step.x * normal.x + step.y * normal.y;
+            if (into < 0.0f) step = Vec2Subtract(step, Vec2Scale(normal, into));
+            Vec2 slidePos = Vec2Add(pos, step);
+            if (!CheckObstacleCollision(slidePos, agentRadius)) {
+                pos = slidePos;
+            }
+        } else {
+            Vec2 slideDir = {-forward.y, forward.x};
+            Vec2 slidePos1 = Vec2Add(pos, Vec2Scale(slideDir, throttle * moveSpeed * dt * 0.5f));
+            Vec2 slidePos2 = Vec2Add(pos, Vec2Scale(slideDir, -throttle * moveSpeed * dt * 0.5f));
+            
+            if (!CheckObstacleCollision(slidePos1, agentRadius)) {
+                pos = slidePos1;
+            } else if (!CheckObstacleCollision(slidePos2, agentRadius)) {
+                pos = slidePos2;
+            }
         }
     }
 
     // Screen wrapping with safety check
-    Vector2 wrappedPos = agent.pos;
+    Vec2 wrappedPos = pos;
     bool needsWrap = false;
-    if (agent.pos.x < 0) { wrappedPos.x = Config::SCREEN_W; needsWrap = true; }
-    else if (agent.pos.x > Config::SCREEN_W) { wrappedPos.x = 0; needsWrap = true; }
-    if (agent.pos.y < 0) { wrappedPos.y = Config::SCREEN_H; needsWrap = true; }
-    else if (agent.pos.y > Config::SCREEN_H) { wrappedPos.y = 0; needsWrap = true; }
+    if (pos.x < 0) { wrappedPos.x = Config::WORLD_W; needsWrap = true; }
+    else if (pos.x > Config::WORLD_W) { wrappedPos.x = 0; needsWrap = true; }
+    if (pos.y < 0) { wrappedPos.y = Config::WORLD_H; needsWrap = true; }
+    else if (pos.y > Config::WORLD_H) { wrappedPos.y = 0; needsWrap = true; }
     
     if (needsWrap && !CheckObstacleCollision(wrappedPos, agentRadius)) {
-        agent.pos = wrappedPos;
+        pos = wrappedPos;
     } else if (needsWrap) {
-        agent.pos.x = std::clamp(agent.pos.x, agentRadius, Config::SCREEN_W - agentRadius);
-        agent.pos.y = std::clamp(agent.pos.y, agentRadius, Config::SCREEN_H - agentRadius);
+        pos.x = std::clamp(pos.x, agentRadius, Config::WORLD_W - agentRadius);
+        pos.y = std::clamp(pos.y, agentRadius, Config::WORLD_H - agentRadius);
     }
 
-    float metabolismRate = Config::METABOLISM_RATE * agent.phenotype.GetMetabolicRate();
-    if (agent.phenotype.species == Species::Predator) metabolismRate *= Config::PREDATOR_METABOLISM_MODIFIER;
+    float metabolismRate = Config::METABOLISM_RATE * phenotype.GetMetabolicRate();
+    if (phenotype.species == Species::Predator) metabolismRate *= Config::PREDATOR_METABOLISM_MODIFIER;
 
     if (season.currentSeason == Season::Winter) metabolismRate *= 1.3f; // Harder to survive in Winter
     if (season.currentSeason == Season::Spring) metabolismRate *= 0.9f; // Easier in Spring
     
-    agent.energy -= metabolismRate * dt;
+    energy -= metabolismRate * dt;
     
-    if (agent.energy <= 0) {
-        agent.active = false;
+    if (energy <= 0) {
+        agents.active[i] = 0;
         stats.deaths++;
         
-        float fitness = agent.CalculateFitness();
+        float fitness = life.CalculateFitness();
         stats.totalFitness += fitness;
         if (fitness > stats.bestFitness) stats.bestFitness = fitness;
 
-        size_t activeCount = std::count_if(agents.begin(), agents.end(), [](const Agent& a){ return a.active; });
-        if (activeCount <= (size_t)Config::ACTIVE_AGENTS && fitness > 5.0f) {
-            savedGenetics.push_back({*agent.brain, agent.phenotype, fitness});
+        if (agents.CountActive() <= Config::ACTIVE_AGENTS && fitness > 5.0f) {
+            savedGenetics.push_back({brain, phenotype, fitness});
         }
         return;
     }
 
-    HandleInteractions(agent, babies);
-}
-
-void World::Draw() {
-    for (const auto& obs : obstacles) {
-        if (obs.active) {
-            obs.Draw();
-        }
-    }
+    MC_PROFILE_SCOPE(profiler, ProfPhase::Interact);
+    HandleInteractions(i, babies);
 }
 
 void World::UpdateSeasons(float dt) {
@@ -811,11 +1052,11 @@ void World::UpdateSeasons(float dt) {
 void World::ThanosSnap() {
     // Balanced perfectly, as all things should be.
     int killCount = 0;
-    for(auto& agent : agents) {
-        if (!agent.active) continue;
-        if (RandomFloat(0,1) > 0.5f) {
-            agent.energy = -10.0f; // Kill
-            agent.active = false;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.active[i]) continue;
+        if (RandomFloat(rng, 0,1) > 0.5f) {
+            agents.energy[i] = -10.0f; // Kill
+            agents.active[i] = 0;
             stats.deaths++; // Make sure deaths are recorded
             killCount++;
         }
@@ -824,32 +1065,33 @@ void World::ThanosSnap() {
 }
 
 void World::FertilityBlessing() {
-    for(auto& agent : agents) {
-        if (agent.active) {
-            agent.energy = Config::AGENT_MAX_ENERGY;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (agents.active[i]) {
+            agents.energy[i] = Config::AGENT_MAX_ENERGY;
         }
     }
 }
 
 void World::ForceMutation() {
-    for(auto& agent : agents) {
-        if (agent.active) {
-            agent.brain->Mutate(0.5f, 0.5f * Config::MUTATION_RATE_MULTIPLIER);
-            agent.phenotype.Mutate(0.5f * Config::MUTATION_RATE_MULTIPLIER);
+    for (size_t i = 0; i < agents.size(); ++i) {
+        if (agents.active[i]) {
+            agents.brain[i]->Mutate(0.5f, 0.5f * Config::MUTATION_RATE_MULTIPLIER, agents.rng[i]);
+            agents.MarkBrainChanged(i);
+            agents.phenotype[i].Mutate(0.5f * Config::MUTATION_RATE_MULTIPLIER, agents.rng[i]);
         }
     }
 }
 
 void World::SpawnSpecies(Species type, int count) {
    for(int i=0; i<count; i++) {
-        Vector2 startPos = FindSafeSpawnPosition(15.0f);
-        Agent a(startPos);
+        Vec2 startPos = FindSafeSpawnPosition(15.0f);
+        Agent a(startPos, rng);
         a.phenotype.species = type;
         // Adjust phenotype based on species default
         if (type == Species::Herbivore) a.phenotype.size = 1.0f;
         if (type == Species::Predator) { a.phenotype.size = 1.2f; a.phenotype.speed = 1.2f; }
         if (type == Species::Scavenger) { a.phenotype.efficiency = 1.2f; }
 
-        agents.push_back(std::move(a));
+        agents.Add(std::move(a));
    }
 }
@@ -0,0 +1,198 @@
+// Render-less runner: steps the world as fast as the CPU allows.
+// Usage: microcosm_headless [--generations N] [--size small|medium|large|huge|custom]
+//                           [--world WxH] [--population N] [--dt SECONDS] [--max-ticks N]
+//                           [--seed N] [--no-obstacles]
+//                           [--profile-csv PATH] [--full-grid] [--validate-grid]
+//                           [--activation exact|rational|polynomial]
+// The final checksum covers the agent state, so two runs with the same seed
+// (and the same build) must print the same value.
+#include "World.hpp"
+#include "Config.hpp"
+#include "Activation.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+struct HeadlessOptions {
+    int generations = 10;
+    float dt = Config::SIM_DT;
+    long long maxTicks = 0; // 0 = unlimited
+    Config::SimSize size = Config::SimSize::Medium;
+    int worldW = 0, worldH = 0; // Custom world size; overrides --size, required by --size custom
+    int population = 0;
+    bool obstacles = true;
+    uint64_t seed = 1;
+    const char* profileCsv = nullptr;
+    bool fullGrid = false;
+    bool validateGrid = false;
+    Config::ActivationMode activation = Config::ACTIVATION;
+};
+
+void PrintUsage(const char* exe) {
+    std::printf("Usage: %s [--generations N] [--size small|medium|large|huge|custom]\n"
+                "          [--world WxH] [--population N] [--dt SECONDS] [--max-ticks N]\n"
+                "          [--seed N] [--no-obstacles]\n"
+                "          [--profile-csv PATH] [--full-grid] [--validate-grid]\n"
+                "          [--activation exact|rational|polynomial]\n", exe);
+}
+
+bool ParseArgs(int argc, char** argv, HeadlessOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--generations") == 0 && hasValue) {
+            opt.generations = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--dt") == 0 && hasValue) {
+            opt.dt = (float)std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--max-ticks") == 0 && hasValue) {
+            opt.maxTicks = std::atoll(argv[++i]);
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            const char* s = argv[++i];
+            if (std::strcmp(s, "small") == 0) opt.size = Config::SimSize::Small;
+            else if (std::strcmp(s, "medium") == 0) opt.size = Config::SimSize::Medium;
+            else if (std::strcmp(s, "large") == 0) opt.size = Config::SimSize::Large;
+            else if (std::strcmp(s, "huge") == 0) opt.size = Config::SimSize::Huge;
+            else if (std::strcmp(s, "custom") == 0) opt.size = Config::SimSize::Custom;
+            else return false;
+        } else if (std::strcmp(arg, "--world") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &opt.worldW, &opt.worldH) != 2) return false;
+            if (opt.worldW <= 0 || opt.worldH <= 0) return false;
+        } else if (std::strcmp(arg, "--population") == 0 && hasValue) {
+            opt.population = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--profile-csv") == 0 && hasValue) {
+            opt.profileCsv = argv[++i];
+        } else if (std::strcmp(arg, "--no-obstacles") == 0) {
+            opt.obstacles = false;
+        } else if (std::strcmp(arg, "--full-grid") == 0) {
+            opt.fullGrid = true;
+        } else if (std::strcmp(arg, "--validate-grid") == 0) {
+            opt.validateGrid = true;
+        } else if (std::strcmp(arg, "--activation") == 0 && hasValue) {
+            const char* s = argv[++i];
+            if (std::strcmp(s, "exact") == 0) opt.activation = Config::ActivationMode::Exact;
+            else if (std::strcmp(s, "rational") == 0) opt.activation = Config::ActivationMode::Rational;
+            else if (std::strcmp(s, "polynomial") == 0) opt.activation = Config::ActivationMode::Polynomial;
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    if (opt.size == Config::SimSize::Custom && opt.worldW <= 0) return false;
+    return opt.generations > 0 && opt.dt > 0.0f;
+}
+
+// FNV-1a over the simulation state that matters for reproducibility
+uint64_t StateChecksum(const World& world) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](const void* data, size_t n) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 0x100000001b3ull; }
+    };
+    const AgentStore& agents = world.agents;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        mix(&agents.pos[i], sizeof(Vec2));
+        mix(&agents.angle[i], sizeof(float));
+        mix(&agents.energy[i], sizeof(float));
+    }
+    mix(&world.stats.generation, sizeof(world.stats.generation));
+    mix(&world.stats.births, sizeof(world.stats.births));
+    mix(&world.stats.deaths, sizeof(world.stats.deaths));
+    return h;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    HeadlessOptions opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    Config::SetSimSize(opt.size);
+    if (opt.worldW > 0) Config::SetWorldSize(opt.worldW, opt.worldH);
+    Config::INITIAL_POPULATION = opt.population;
+    Config::OBSTACLES_ENABLED = opt.obstacles;
+    Config::INCREMENTAL_GRID = !opt.fullGrid;
+    Config::VALIDATE_GRID = opt.validateGrid;
+    Config::ACTIVATION = opt.activation;
+
+    World world(opt.seed);
+    
+    std::FILE* profileCsv = nullptr;
+    if (opt.profileCsv) {
+        if (!TickProfiler::Enabled()) {
+            std::fprintf(stderr, "Profiling was compiled out (MICROCOSM_PROFILING=OFF)\n");
+            return 1;
+        }
+        profileCsv = std::fopen(opt.profileCsv, "w");
+        if (!profileCsv) {
+            std::fprintf(stderr, "Could not open %s\n", opt.profileCsv);
+            return 1;
+        }
+        TickProfiler::WriteCsvHeader(profileCsv);
+    }
+    double phaseTotals[PROF_PHASE_COUNT] = {};
+    int startGeneration = world.stats.generation;
+    int targetGeneration = startGeneration + opt.generations;
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto genStart = start;
+    long long ticks = 0;
+    long long genTicks = 0;
+
+    while (world.stats.generation < targetGeneration) {
+        if (opt.maxTicks > 0 && ticks >= opt.maxTicks) break;
+
+        int gen = world.stats.generation;
+        world.Update(opt.dt);
+        ++ticks;
+        ++genTicks;
+        
+        if (const TickProfile* p = world.profiler.Last()) {
+            for (int i = 0; i < PROF_PHASE_COUNT; ++i) phaseTotals[i] += p->ms[i];
+            if (profileCsv) TickProfiler::WriteCsvRow(profileCsv, ticks, *p);
+        }
+
+        if (world.stats.generation != gen) {
+            auto now = Clock::now();
+            double secs = std::chrono::duration<double>(now - genStart).count();
+            const auto& h = world.stats.history.back();
+            std::printf("gen %4d | ticks %8lld | %10.0f ticks/s | avg fit %8.2f | best %8.2f | max pop %d\n",
+                        gen, genTicks, secs > 0.0 ? genTicks / secs : 0.0,
+                        h.avgFitness, h.bestFitness, h.population);
+            genStart = now;
+            genTicks = 0;
+        }
+    }
+
+    double total = std::chrono::duration<double>(Clock::now() - start).count();
+    double simSeconds = ticks * (double)opt.dt;
+    std::printf("\n%lld ticks in %.2fs: %.0f ticks/s (%.1fx real time)\n",
+                ticks, total, total > 0.0 ? ticks / total : 0.0,
+                total > 0.0 ? simSeconds / total : 0.0);
+    std::printf("seed %llu | %s tanh | state checksum %016llx\n",
+                (unsigned long long)opt.seed, Activation::ModeName(opt.activation),
+                (unsigned long long)StateChecksum(world));
+    
+    if (TickProfiler::Enabled() && ticks > 0) {
+        std::printf("\nphase averages (us/tick, Sense/Think/Interact nested in Agents):\n");
+        for (int i = 0; i < PROF_PHASE_COUNT; ++i) {
+            std::printf("  %-12s %10.2f\n", GetPhaseName((ProfPhase)i), phaseTotals[i] * 1000.0 / ticks);
+        }
+    }
+    if (profileCsv) std::fclose(profileCsv);
+    
+    if (opt.validateGrid) {
+        std::printf("\ngrid validation: %d mismatching ticks\n", world.gridValidationErrors);
+        if (world.gridValidationErrors > 0) return 2;
+    }
+    return 0;
+}
@@ -1,10 +1,12 @@
 #include "raylib.h"
+#include "raymath.h"
 #include "World.hpp"
 #include "Config.hpp"
 #include "Brain.hpp"
 #include "RNNBrain.hpp"
 #include "NEATBrain.hpp"
 #include "UISystem.hpp"
+#include "Render.hpp"
 #include "rlImGui.h"
 #include "imgui.h"
 #include "implot.h"
@@ -14,30 +16,33 @@ void HandleGodModeInput(UIState& ui, World& world) {
     if (!ui.godMode || ui.currentTool == UIState::SpawnTool::None) return;
     if (ImGui::GetIO().WantCaptureMouse) return;
 
-    Vector2 mouseWorld = GetScreenToWorld2D(GetMousePosition(), ui.camera);
+    Vec2 mouseWorld = FromRaylib(GetScreenToWorld2D(GetMousePosition(), ui.camera));
     
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         switch (ui.currentTool) {
-            case UIState::SpawnTool::Fruit: world.fruits.push_back({mouseWorld}); break;
-            case UIState::SpawnTool::Poison: world.poisons.push_back({mouseWorld}); break;
-            case UIState::SpawnTool::Agent: world.agents.emplace_back(mouseWorld); break;
+            case UIState::SpawnTool::Fruit: world.fruits.Spawn({mouseWorld}); break;
+            case UIState::SpawnTool::Poison: world.poisons.Spawn({mouseWorld}); break;
+            case UIState::SpawnTool::Agent: world.agents.Add(Agent(mouseWorld, world.rng)); break;
             case UIState::SpawnTool::AgentRNN: {
-                Agent a(mouseWorld);
-                a.brain = std::make_unique<RNNBrain>(7, 8, 3);
-                world.agents.push_back(std::move(a));
+                Agent a(mouseWorld, world.rng);
+                a.brain = std::make_unique<RNNBrain>(BRAIN_INPUTS, 8, BRAIN_OUTPUTS, a.rng);
+                world.agents.Add(std::move(a));
                 break;
             }
             case UIState::SpawnTool::AgentNEAT: {
-                Agent a(mouseWorld);
-                a.brain = std::make_unique<NEATBrain>(7, 3);
-                world.agents.push_back(std::move(a));
+                Agent a(mouseWorld, world.rng);
+                a.brain = std::make_unique<NEATBrain>(BRAIN_INPUTS, BRAIN_OUTPUTS, world.innovations, a.rng);
+                world.agents.Add(std::move(a));
                 break;
             }
             case UIState::SpawnTool::Erase: {
                 float eraseRadius = 30.0f;
-                for (auto& f : world.fruits) if (f.active && Vector2Distance(f.pos, mouseWorld) < eraseRadius) f.active = false;
-                for (auto& p : world.poisons) if (p.active && Vector2Distance(p.pos, mouseWorld) < eraseRadius) p.active = false;
-                for (auto& a : world.agents) if (a.active && Vector2Distance(a.pos, mouseWorld) < eraseRadius) { a.active = false; world.stats.deaths++; }
+                for (int i = 0; i < (int)world.fruits.size(); ++i) if (world.fruits[i].active && Vec2Distance(world.fruits[i].pos, mouseWorld) < eraseRadius) world.fruits.Release(i);
+                for (int i = 0; i < (int)world.poisons.size(); ++i) if (world.poisons[i].active && Vec2Distance(world.poisons[i].pos, mouseWorld) < eraseRadius) world.poisons.Release(i);
+                AgentStore& agents = world.agents;
+                for (size_t i = 0; i < agents.size(); ++i) {
+                    if (agents.active[i] && Vec2Distance(agents.pos[i], mouseWorld) < eraseRadius) { agents.active[i] = 0; world.stats.deaths++; }
+                }
                 break;
             }
             default: break;
@@ -45,8 +50,49 @@ void HandleGodModeInput(UIState& ui, World& world) {
     }
 }
 
+// Advances the world in fixed Config::SIM_DT ticks.
+// Normal mode consumes frame time through an accumulator (scaled by the speed
+// slider); turbo mode ignores wall-clock time and runs ticks until the CPU
+// budget for this frame is spent.
+void StepSimulation(UIState& ui, World& world, float frameTime) {
+    static double rateWindowStart = GetTime();
+    static int rateWindowTicks = 0;
+
+    int ticks = 0;
+    if (ui.paused) {
+        ui.tickAccumulator = 0.0f;
+    } else if (ui.turbo) {
+        double deadline = GetTime() + ui.turboBudgetMs / 1000.0;
+        do {
+            world.Update(Config::SIM_DT);
+            ++ticks;
+        } while (GetTime() < deadline);
+        ui.tickAccumulator = 0.0f;
+    } else {
+        ui.tickAccumulator += frameTime * ui.timeScale;
+        while (ui.tickAccumulator >= Config::SIM_DT && ticks < Config::MAX_TICKS_PER_FRAME) {
+            world.Update(Config::SIM_DT);
+            ui.tickAccumulator -= Config::SIM_DT;
+            ++ticks;
+        }
+        // Drop time we could not catch up on rather than spiralling
+        if (ticks == Config::MAX_TICKS_PER_FRAME) ui.tickAccumulator = 0.0f;
+    }
+    ui.renderAlpha = (ui.paused || ui.turbo) ? 1.0f : ui.tickAccumulator / Config::SIM_DT;
+
+    ui.ticksLastFrame = ticks;
+    rateWindowTicks += ticks;
+    double now = GetTime();
+    if (now - rateWindowStart >= 0.5) {
+        ui.ticksPerSecond = (float)(rateWindowTicks / (now - rateWindowStart));
+        rateWindowStart = now;
+        rateWindowTicks = 0;
+    }
+}
+
 int main() {
-    InitWindow(Config::SCREEN_W, Config::SCREEN_H, "MicroCosmSim - Refactored");
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(Config::WINDOW_W, Config::WINDOW_H, "MicroCosmSim - Refactored");
     SetTargetFPS(60);
     rlImGuiSetup(true);
     ImPlot::CreateContext();
@@ -55,63 +101,31 @@ int main() {
     UISystem uiSystem;
     UIState ui;
     
-    ui.camera.offset = { Config::SCREEN_W / 2.0f, Config::SCREEN_H / 2.0f };
-    ui.camera.target = { Config::SCREEN_W / 2.0f, Config::SCREEN_H / 2.0f };
-    ui.camera.zoom = 1.0f;
+    ResetCamera(ui);
 
     while (!WindowShouldClose()) {
-        float dt = ui.paused ? 0.0f : GetFrameTime() * ui.timeScale;
-        
+        if (IsWindowResized()) ui.camera.offset = { GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
         if (ui.freeCam) {
             if (IsMouseButtonDown(MOUSE_RIGHT_BUTTON)) {
                 ui.camera.target = Vector2Add(ui.camera.target, Vector2Scale(GetMouseDelta(), -1.0f / ui.camera.zoom));
             }
-            ui.camera.zoom = std::clamp(ui.camera.zoom + GetMouseWheelMove() * 0.1f, 0.5f, 3.0f);
+            // Multiplicative so the wheel stays usable when a large world is zoomed far out
+            float minZoom = std::min(0.5f, FitZoom() * 0.5f);
+            ui.camera.zoom = std::clamp(ui.camera.zoom * (1.0f + GetMouseWheelMove() * 0.1f), minZoom, 3.0f);
         }
         
-        world.Update(dt);
+        StepSimulation(ui, world, GetFrameTime());
         HandleGodModeInput(ui, world);
 
         BeginDrawing();
         ClearBackground({20, 20, 25, 255});
         BeginMode2D(ui.camera);
 
-        world.Draw();
-
-        for (const auto& f : world.fruits) if (f.active) DrawCircleV(f.pos, 3.0f, GREEN);
-        for (const auto& p : world.poisons) if (p.active) DrawRectangleV(Vector2Subtract(p.pos, {3,3}), {6,6}, PURPLE);
+        DrawWorld(world, ui.camera, ui.renderAlpha);
 
-        for (const auto& a : world.agents) {
-            if (!a.active) continue;
-            
-            Color col = WHITE;
-            switch(a.phenotype.species) {
-                case Species::Herbivore: col = {100, 255, 100, 255}; break; // Green
-                case Species::Scavenger: col = {255, 165, 0, 255}; break;   // Orange
-                case Species::Predator:  col = {255, 50, 50, 255}; break;   // Red
-            }
-            col.a = (unsigned char)(std::max(0.2f, a.energy / Config::AGENT_MAX_ENERGY) * 255);
-            
-            float visualSize = a.phenotype.GetVisualSize();
-            
-            // Pheromone Aura
-            if(a.pheromoneEmission > 0.1f) {
-                Color aura = {200, 100, 255, (unsigned char)(a.pheromoneEmission * 50)};
-                DrawCircleV(a.pos, visualSize + 10 * a.pheromoneEmission, aura);
-            }
-            
-            DrawCircleV(a.pos, visualSize, col);
-            
-            // Sex Indicator
-            Color sexCol = (a.sex == Sex::Male) ? BLUE : PINK;
-            DrawCircleV(a.pos, visualSize * 0.4f, sexCol);
-            
-            Vector2 head = { a.pos.x + cos(a.angle)*(visualSize + 3), a.pos.y + sin(a.angle)*(visualSize + 3) };
-            DrawLineV(a.pos, head, RAYWHITE);
-        }
-        
-        if (ui.selectedAgentIdx >= 0 && ui.selectedAgentIdx < (int)world.agents.size()) {
-            if (world.agents[ui.selectedAgentIdx].active) DrawCircleLines(world.agents[ui.selectedAgentIdx].pos.x, world.agents[ui.selectedAgentIdx].pos.y, 15.0f, YELLOW);
+        if (int idx = world.agents.IndexOf(ui.selectedAgent); idx >= 0) {
+            AgentRef a = world.agents[idx];
+            if (a.active) DrawCircleLines(a.pos.x, a.pos.y, 15.0f, YELLOW);
         }
         
         EndMode2D();
@@ -0,0 +1,80 @@
+// Allocation regression test: brain inference and a steady-state world tick
+// must not touch the heap. Links bench/AllocCounter.cpp, which replaces the
+// global operator new with a counting one.
+#include "AllocCounter.hpp"
+#include "World.hpp"
+#include "Config.hpp"
+#include "NeuralNetwork.hpp"
+#include "RNNBrain.hpp"
+#include "NEATBrain.hpp"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool ok, const std::string& what) {
+    std::printf("%s %s\n", ok ? "PASS" : "FAIL", what.c_str());
+    if (!ok) g_failures++;
+}
+
+void CheckFeedForward(const std::string& label, IBrain& brain, Rng& rng) {
+    std::vector<float> inputs(brain.GetInputSize());
+    std::vector<float> outputs(brain.GetOutputSize());
+    for (auto& v : inputs) v = RandomFloat(rng, -1.0f, 1.0f);
+
+    brain.FeedForward(inputs, outputs); // Warm-up
+    long long start = AllocCount();
+    for (int i = 0; i < 100; ++i) brain.FeedForward(inputs, outputs);
+    long long allocs = AllocCount() - start;
+    Check(allocs == 0, label + " FeedForward: " + std::to_string(allocs) + " allocations");
+}
+
+void TestBrains() {
+    Rng rng(7);
+    NeuralNetwork nn(BRAIN_INPUTS, 16, BRAIN_OUTPUTS, rng);
+    CheckFeedForward("NN", nn, rng);
+
+    RNNBrain rnn(BRAIN_INPUTS, 16, BRAIN_OUTPUTS, rng);
+    CheckFeedForward("RNN", rnn, rng);
+
+    // Grow a few hidden nodes so the compiled network has real depth
+    NEATBrain neat(BRAIN_INPUTS, BRAIN_OUTPUTS, std::make_shared<InnovationRegistry>(), rng);
+    for (int i = 0; i < 50; ++i) neat.Mutate(1.0f, 0.5f, rng);
+    CheckFeedForward("NEAT", neat, rng);
+}
+
+// With no births or deaths the population is fixed; eating and respawning
+// only recycle pooled slots, so every tick after warm-up must be allocation-free
+void TestWorldUpdate() {
+    Config::SetSimSize(Config::SimSize::Medium);
+    Config::METABOLISM_RATE = 0.0f;
+    Config::POISON_DAMAGE = 0.0f;
+    Config::COLLISION_ENERGY_PENALTY = 0.0f;
+    Config::PREDATOR_STEAL_AMOUNT = 0.0f;
+    Config::MATING_ENERGY_THRESHOLD = Config::AGENT_MAX_ENERGY + 1.0f;
+
+    World world(42);
+    for (int i = 0; i < 300; ++i) world.Update(Config::SIM_DT);
+
+    int population = (int)world.agents.size();
+    long long start = AllocCount();
+    // Long enough to cross a season change (SEASON_DURATION seconds)
+    for (int i = 0; i < 2000; ++i) world.Update(Config::SIM_DT);
+    long long allocs = AllocCount() - start;
+
+    Check((int)world.agents.size() == population && world.stats.births == 0 && world.stats.deaths == 0,
+          "population stays fixed");
+    Check(allocs == 0, "World::Update steady state: " + std::to_string(allocs) + " allocations");
+}
+
+} // namespace
+
+int main() {
+    TestBrains();
+    TestWorldUpdate();
+    return g_failures == 0 ? 0 : 1;
+}